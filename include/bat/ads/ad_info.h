@@ -17,6 +17,9 @@ namespace ads {
 struct ADS_EXPORT AdInfo {
   AdInfo();
   AdInfo(const AdInfo& info);
+  AdInfo(AdInfo&& info) noexcept;
+  AdInfo& operator=(const AdInfo& info);
+  AdInfo& operator=(AdInfo&& info) noexcept;
   ~AdInfo();
 
   const std::string ToJson() const;
@@ -6,9 +6,12 @@
 #ifndef BAT_ADS_ADS_H_
 #define BAT_ADS_ADS_H_
 
+#include <atomic>
 #include <string>
+#include <memory>
 
 #include "bat/ads/ads_client.h"
+#include "bat/ads/diagnostics_info.h"
 #include "bat/ads/export.h"
 #include "bat/ads/notification_result_type.h"
 #include "bat/ads/notification_info.h"
@@ -26,9 +29,15 @@ extern bool _is_testing;
 // Determines whether to use the staging or production Ad Serve
 extern bool _is_production;
 
+// Log messages less severe than |_log_level| are discarded without being
+// built. Can be changed at any time, i.e. to |LOG_ERROR| on release builds
+extern std::atomic<LogLevel> _log_level;
+
 extern const char _bundle_schema_name[];
 extern const char _catalog_schema_name[];
+extern const char _catalog_delta_schema_name[];
 extern const char _catalog_name[];
+extern const char _compressed_catalog_name[];
 extern const char _client_name[];
 
 class ADS_EXPORT Ads {
@@ -112,6 +121,16 @@ class ADS_EXPORT Ads {
       const NotificationInfo& info,
       const NotificationResultInfoResultType type) = 0;
 
+  // Should be called to get a snapshot of the counters and latency histograms
+  // recorded by Ads for export. The snapshot is empty if Ads was built without
+  // metrics
+  virtual std::unique_ptr<DiagnosticsInfo> GetDiagnostics() = 0;
+
+  // Should be called to get the most recent trace events recorded by Ads as
+  // Chrome Trace Event JSON, which can be loaded into chrome://tracing or
+  // Perfetto. No events are recorded if Ads was built without tracing
+  virtual std::string GetTraceEvents() = 0;
+
  private:
   // Not copyable, not assignable
   Ads(const Ads&) = delete;
@@ -46,6 +46,9 @@ class ADS_EXPORT LogStream {
 using OnSaveCallback = std::function<void(const Result)>;
 using OnLoadCallback = std::function<void(const Result, const std::string&)>;
 
+using BackgroundTask = std::function<void()>;
+using OnBackgroundTaskCallback = std::function<void()>;
+
 using OnResetCallback = std::function<void(const Result)>;
 
 using OnGetAdsCallback = std::function<void(const Result,
@@ -93,6 +96,17 @@ class ADS_EXPORT AdsClient {
       const std::string& locale,
       OnLoadCallback callback) const = 0;
 
+  // Should run |task| on a background thread and then call |callback| on the
+  // calling thread once |task| has completed. |task| does not call back into
+  // Ads. Unless overridden, |task| and then |callback| are run on the calling
+  // thread
+  virtual void RunInBackground(
+      BackgroundTask task,
+      OnBackgroundTaskCallback callback) {
+    task();
+    callback();
+  }
+
   // Should generate return a v4 UUID
   virtual const std::string GenerateUUID() const = 0;
 
@@ -141,6 +155,24 @@ class ADS_EXPORT AdsClient {
       std::unique_ptr<BundleState> state,
       OnSaveCallback callback) = 0;
 
+  // Should begin saving a new bundle state to persistent storage, |state| only
+  // contains the catalog metadata. The previously saved bundle state should
+  // continue to be used for getting ads until |CommitBundleState| is called
+  virtual void BeginSaveBundleState(std::unique_ptr<BundleState> state) = 0;
+
+  // Should append a batch of categories to the bundle state being saved, each
+  // category is only included in one batch
+  virtual void SaveBundleStateCategories(
+      std::unique_ptr<BundleState> state) = 0;
+
+  // Should atomically replace the previously saved bundle state with the
+  // bundle state being saved
+  virtual void CommitBundleState(OnSaveCallback callback) = 0;
+
+  // Should discard the bundle state being saved, the previously saved bundle
+  // state should remain unchanged
+  virtual void AbortBundleState() = 0;
+
   // Should load a value from persistent storage
   virtual void Load(const std::string& name, OnLoadCallback callback) = 0;
 
@@ -18,6 +18,9 @@ namespace ads {
 struct BundleState {
   BundleState();
   explicit BundleState(const BundleState& state);
+  BundleState(BundleState&& state) noexcept;
+  BundleState& operator=(const BundleState& state);
+  BundleState& operator=(BundleState&& state) noexcept;
   ~BundleState();
 
   const std::string ToJson() const;
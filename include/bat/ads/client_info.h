@@ -17,6 +17,9 @@ namespace ads {
 struct ADS_EXPORT ClientInfo {
   ClientInfo();
   ClientInfo(const ClientInfo& info);
+  ClientInfo(ClientInfo&& info) noexcept;
+  ClientInfo& operator=(const ClientInfo& info);
+  ClientInfo& operator=(ClientInfo&& info) noexcept;
   ~ClientInfo();
 
   const std::string ToJson() const;
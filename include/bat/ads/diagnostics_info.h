@@ -0,0 +1,34 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_DIAGNOSTICS_INFO_H_
+#define BAT_ADS_DIAGNOSTICS_INFO_H_
+
+#include <stdint.h>
+#include <string>
+#include <map>
+
+#include "bat/ads/export.h"
+#include "bat/ads/histogram_info.h"
+
+namespace ads {
+
+struct ADS_EXPORT DiagnosticsInfo {
+  DiagnosticsInfo();
+  DiagnosticsInfo(const DiagnosticsInfo& info);
+  DiagnosticsInfo(DiagnosticsInfo&& info) noexcept;
+  DiagnosticsInfo& operator=(const DiagnosticsInfo& info);
+  DiagnosticsInfo& operator=(DiagnosticsInfo&& info) noexcept;
+  ~DiagnosticsInfo();
+
+  const std::string ToJson() const;
+
+  std::map<std::string, uint64_t> counters;
+  std::map<std::string, HistogramInfo> histograms;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_DIAGNOSTICS_INFO_H_
@@ -0,0 +1,38 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_HISTOGRAM_INFO_H_
+#define BAT_ADS_HISTOGRAM_INFO_H_
+
+#include <stdint.h>
+#include <map>
+
+#include "bat/ads/export.h"
+
+namespace ads {
+
+// Latencies in microseconds. Percentiles are the lower bound of the bucket
+// they fall in, and buckets map the lower bound of each non-empty bucket to
+// its count
+struct ADS_EXPORT HistogramInfo {
+  HistogramInfo();
+  HistogramInfo(const HistogramInfo& info);
+  HistogramInfo(HistogramInfo&& info) noexcept;
+  HistogramInfo& operator=(const HistogramInfo& info);
+  HistogramInfo& operator=(HistogramInfo&& info) noexcept;
+  ~HistogramInfo();
+
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  std::map<uint64_t, uint64_t> buckets;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_HISTOGRAM_INFO_H_
@@ -15,6 +15,9 @@ namespace ads {
 struct ADS_EXPORT IssuerInfo {
   IssuerInfo();
   IssuerInfo(const IssuerInfo& info);
+  IssuerInfo(IssuerInfo&& info) noexcept;
+  IssuerInfo& operator=(const IssuerInfo& info);
+  IssuerInfo& operator=(IssuerInfo&& info) noexcept;
   ~IssuerInfo();
 
   std::string name;
@@ -18,6 +18,9 @@ namespace ads {
 struct ADS_EXPORT IssuersInfo {
   IssuersInfo();
   IssuersInfo(const IssuersInfo& info);
+  IssuersInfo(IssuersInfo&& info) noexcept;
+  IssuersInfo& operator=(const IssuersInfo& info);
+  IssuersInfo& operator=(IssuersInfo&& info) noexcept;
   ~IssuersInfo();
 
   const std::string ToJson() const;
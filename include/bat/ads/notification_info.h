@@ -16,6 +16,9 @@ namespace ads {
 struct ADS_EXPORT NotificationInfo {
   NotificationInfo();
   explicit NotificationInfo(const NotificationInfo& info);
+  NotificationInfo(NotificationInfo&& info) noexcept;
+  NotificationInfo& operator=(const NotificationInfo& info);
+  NotificationInfo& operator=(NotificationInfo&& info) noexcept;
   ~NotificationInfo();
 
   const std::string ToJson() const;
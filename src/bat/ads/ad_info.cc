@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <utility>
+
 #include "bat/ads/ad_info.h"
 
 #include "bat/ads/internal/json_helper.h"
@@ -37,6 +39,12 @@ AdInfo::AdInfo(const AdInfo& info) :
     notification_url(info.notification_url),
     uuid(info.uuid) {}
 
+AdInfo::AdInfo(AdInfo&& info) noexcept = default;
+
+AdInfo& AdInfo::operator=(const AdInfo& info) = default;
+
+AdInfo& AdInfo::operator=(AdInfo&& info) noexcept = default;
+
 AdInfo::~AdInfo() = default;
 
 const std::string AdInfo::ToJson() const {
@@ -93,7 +101,7 @@ Result AdInfo::FromJson(
       new_regions.push_back(region.GetString());
     }
   }
-  regions = new_regions;
+  regions = std::move(new_regions);
 
   if (document.HasMember("advertiser")) {
     advertiser = document["advertiser"].GetString();
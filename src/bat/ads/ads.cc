@@ -13,9 +13,13 @@ bool _is_debug = false;
 bool _is_testing = false;
 bool _is_production = false;
 
+std::atomic<LogLevel> _log_level(LOG_INFO);
+
 const char _bundle_schema_name[] = "bundle-schema.json";
 const char _catalog_schema_name[] = "catalog-schema.json";
+const char _catalog_delta_schema_name[] = "catalog-delta-schema.json";
 const char _catalog_name[] = "catalog.json";
+const char _compressed_catalog_name[] = "catalog.json.gz";
 const char _client_name[] = "client.json";
 
 // static
@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <utility>
+
 #include "bat/ads/bundle_state.h"
 
 #include "bat/ads/internal/json_helper.h"
@@ -25,6 +27,12 @@ BundleState::BundleState(const BundleState& state):
         state.catalog_last_updated_timestamp_in_seconds),
     categories(state.categories) {}
 
+BundleState::BundleState(BundleState&& state) noexcept = default;
+
+BundleState& BundleState::operator=(const BundleState& state) = default;
+
+BundleState& BundleState::operator=(BundleState&& state) noexcept = default;
+
 BundleState::~BundleState() = default;
 
 const std::string BundleState::ToJson() const {
@@ -37,13 +45,15 @@ Result BundleState::FromJson(
     const std::string& json,
     const std::string& json_schema,
     std::string* error_description) {
-  rapidjson::Document bundle;
-  bundle.Parse(json.c_str());
+  rapidjson::MemoryPoolAllocator<> allocator(
+      helper::JSON::GetMemoryPoolChunkCapacity(json));
+  rapidjson::Document bundle(&allocator);
+  bundle.Parse(json.c_str(), json.size());
 
   auto result = helper::JSON::Validate(&bundle, json_schema);
   if (result != SUCCESS) {
     if (error_description != nullptr) {
-      *error_description = helper::JSON::GetLastError(&bundle);
+      *error_description = helper::JSON::GetLastError(&bundle, json);
     }
 
     return result;
@@ -102,12 +112,13 @@ Result BundleState::FromJson(
             new_categories.end()) {
           new_categories.insert({category.name.GetString(), {}});
         }
-        new_categories.at(category.name.GetString()).push_back(ad_info);
+        new_categories.at(category.name.GetString()).push_back(
+            std::move(ad_info));
       }
     }
   }
 
-  categories = new_categories;
+  categories = std::move(new_categories);
 
   return SUCCESS;
 }
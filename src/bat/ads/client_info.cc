@@ -15,6 +15,12 @@ ClientInfo::ClientInfo() :
 ClientInfo::ClientInfo(const ClientInfo& info) :
     platform(info.platform) {}
 
+ClientInfo::ClientInfo(ClientInfo&& info) noexcept = default;
+
+ClientInfo& ClientInfo::operator=(const ClientInfo& info) = default;
+
+ClientInfo& ClientInfo::operator=(ClientInfo&& info) noexcept = default;
+
 ClientInfo::~ClientInfo() = default;
 
 const std::string ClientInfo::ToJson() const {
@@ -0,0 +1,86 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/diagnostics_info.h"
+
+#include "bat/ads/internal/json_helper.h"
+
+namespace ads {
+
+DiagnosticsInfo::DiagnosticsInfo() :
+    counters({}),
+    histograms({}) {}
+
+DiagnosticsInfo::DiagnosticsInfo(const DiagnosticsInfo& info) = default;
+
+DiagnosticsInfo::DiagnosticsInfo(DiagnosticsInfo&& info) noexcept = default;
+
+DiagnosticsInfo& DiagnosticsInfo::operator=(
+    const DiagnosticsInfo& info) = default;
+
+DiagnosticsInfo& DiagnosticsInfo::operator=(
+    DiagnosticsInfo&& info) noexcept = default;
+
+DiagnosticsInfo::~DiagnosticsInfo() = default;
+
+const std::string DiagnosticsInfo::ToJson() const {
+  std::string json;
+  SaveToJson(*this, &json);
+  return json;
+}
+
+void SaveToJson(JsonWriter* writer, const DiagnosticsInfo& info) {
+  writer->StartObject();
+
+  writer->String("counters");
+  writer->StartObject();
+  for (const auto& counter : info.counters) {
+    writer->String(counter.first.c_str());
+    writer->Uint64(counter.second);
+  }
+  writer->EndObject();
+
+  writer->String("histograms");
+  writer->StartObject();
+  for (const auto& histogram : info.histograms) {
+    writer->String(histogram.first.c_str());
+    writer->StartObject();
+
+    writer->String("count");
+    writer->Uint64(histogram.second.count);
+
+    writer->String("sum");
+    writer->Uint64(histogram.second.sum);
+
+    writer->String("max");
+    writer->Uint64(histogram.second.max);
+
+    writer->String("p50");
+    writer->Uint64(histogram.second.p50);
+
+    writer->String("p90");
+    writer->Uint64(histogram.second.p90);
+
+    writer->String("p99");
+    writer->Uint64(histogram.second.p99);
+
+    writer->String("buckets");
+    writer->StartArray();
+    for (const auto& bucket : histogram.second.buckets) {
+      writer->StartArray();
+      writer->Uint64(bucket.first);
+      writer->Uint64(bucket.second);
+      writer->EndArray();
+    }
+    writer->EndArray();
+
+    writer->EndObject();
+  }
+  writer->EndObject();
+
+  writer->EndObject();
+}
+
+}  // namespace ads
@@ -0,0 +1,30 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/histogram_info.h"
+
+namespace ads {
+
+HistogramInfo::HistogramInfo() :
+    count(0),
+    sum(0),
+    max(0),
+    p50(0),
+    p90(0),
+    p99(0),
+    buckets({}) {}
+
+HistogramInfo::HistogramInfo(const HistogramInfo& info) = default;
+
+HistogramInfo::HistogramInfo(HistogramInfo&& info) noexcept = default;
+
+HistogramInfo& HistogramInfo::operator=(const HistogramInfo& info) = default;
+
+HistogramInfo& HistogramInfo::operator=(
+    HistogramInfo&& info) noexcept = default;
+
+HistogramInfo::~HistogramInfo() = default;
+
+}  // namespace ads
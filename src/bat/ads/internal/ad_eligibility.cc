@@ -0,0 +1,183 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "bat/ads/internal/ad_eligibility.h"
+
+#include "base/time/time.h"
+
+namespace ads {
+
+namespace {
+
+const uint64_t kRollingWindowInSeconds =
+    base::Time::kSecondsPerHour * base::Time::kHoursPerDay;
+
+const std::deque<uint64_t>& GetHistory(
+    const AdHistory& ad_history,
+    const std::string& id) {
+  static const std::deque<uint64_t> kEmptyHistory;
+
+  auto it = ad_history.find(id);
+  if (it == ad_history.end()) {
+    return kEmptyHistory;
+  }
+
+  return it->second;
+}
+
+}  // namespace
+
+AdEligibility::AdEligibility() :
+    serving_index_(nullptr),
+    next_update_timestamp_in_seconds_(0),
+    next_flight_boundary_in_seconds_(0) {
+}
+
+AdEligibility::~AdEligibility() = default;
+
+bool AdEligibility::IsStale(
+    const ServingIndex* serving_index,
+    const uint64_t now_in_seconds) const {
+  if (serving_index_.get() != serving_index) {
+    return true;
+  }
+
+  return now_in_seconds >= next_update_timestamp_in_seconds_;
+}
+
+void AdEligibility::Update(
+    std::shared_ptr<const ServingIndex> serving_index,
+    const AdHistory& creative_set_history,
+    const AdHistory& campaign_history,
+    const uint64_t now_in_seconds) {
+  serving_index_ = std::move(serving_index);
+  next_update_timestamp_in_seconds_ = std::numeric_limits<uint64_t>::max();
+
+  auto creative_sets = serving_index_->GetCreativeSets().size();
+  capped_creative_sets_.assign(creative_sets, false);
+  for (uint32_t i = 0; i < creative_sets; i++) {
+    UpdateCreativeSet(i, creative_set_history, now_in_seconds);
+  }
+
+  auto campaigns = serving_index_->GetCampaigns().size();
+  capped_campaigns_.assign(campaigns, false);
+  for (uint32_t i = 0; i < campaigns; i++) {
+    UpdateCampaign(i, campaign_history, now_in_seconds);
+  }
+
+  next_flight_boundary_in_seconds_ = 0;
+  UpdateFlightWindows(now_in_seconds);
+}
+
+void AdEligibility::UpdateFlightWindows(const uint64_t now_in_seconds) {
+  if (!serving_index_ || now_in_seconds < next_flight_boundary_in_seconds_) {
+    return;
+  }
+
+  const auto& campaigns = serving_index_->GetCampaigns();
+
+  out_of_flight_campaigns_.assign(campaigns.size(), false);
+  for (size_t i = 0; i < campaigns.size(); i++) {
+    const auto& campaign = campaigns.at(i);
+    out_of_flight_campaigns_[i] =
+        now_in_seconds < campaign.start_timestamp_in_seconds ||
+        now_in_seconds >= campaign.end_timestamp_in_seconds;
+  }
+
+  next_flight_boundary_in_seconds_ =
+      serving_index_->GetNextFlightBoundary(now_in_seconds);
+}
+
+void AdEligibility::OnImpression(
+    const std::string& creative_set_id,
+    const std::string& campaign_id,
+    const AdHistory& creative_set_history,
+    const AdHistory& campaign_history,
+    const uint64_t now_in_seconds) {
+  if (!serving_index_) {
+    return;
+  }
+
+  uint32_t index;
+
+  if (serving_index_->GetCreativeSetIndex(creative_set_id, &index)) {
+    UpdateCreativeSet(index, creative_set_history, now_in_seconds);
+  }
+
+  if (serving_index_->GetCampaignIndex(campaign_id, &index)) {
+    UpdateCampaign(index, campaign_history, now_in_seconds);
+  }
+}
+
+void AdEligibility::Reset() {
+  serving_index_.reset();
+  capped_creative_sets_.clear();
+  capped_campaigns_.clear();
+  out_of_flight_campaigns_.clear();
+  next_update_timestamp_in_seconds_ = 0;
+  next_flight_boundary_in_seconds_ = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void AdEligibility::UpdateCreativeSet(
+    const uint32_t index,
+    const AdHistory& creative_set_history,
+    const uint64_t now_in_seconds) {
+  const auto& creative_set = serving_index_->GetCreativeSets().at(index);
+  const auto& history =
+      GetHistory(creative_set_history, creative_set.creative_set_id);
+
+  if (history.size() >= creative_set.total_max) {
+    capped_creative_sets_[index] = true;
+    return;
+  }
+
+  capped_creative_sets_[index] =
+      IsCapped(history, creative_set.per_day, now_in_seconds);
+}
+
+void AdEligibility::UpdateCampaign(
+    const uint32_t index,
+    const AdHistory& campaign_history,
+    const uint64_t now_in_seconds) {
+  const auto& campaign = serving_index_->GetCampaigns().at(index);
+  const auto& history = GetHistory(campaign_history, campaign.campaign_id);
+
+  capped_campaigns_[index] =
+      IsCapped(history, campaign.daily_cap, now_in_seconds);
+}
+
+bool AdEligibility::IsCapped(
+    const std::deque<uint64_t>& history,
+    const uint64_t allowable_ad_count,
+    const uint64_t now_in_seconds) {
+  uint64_t recent_count = 0;
+  uint64_t oldest_timestamp_in_seconds = std::numeric_limits<uint64_t>::max();
+
+  for (const auto& timestamp_in_seconds : history) {
+    if (now_in_seconds - timestamp_in_seconds < kRollingWindowInSeconds) {
+      recent_count++;
+      oldest_timestamp_in_seconds =
+          std::min(oldest_timestamp_in_seconds, timestamp_in_seconds);
+    }
+  }
+
+  if (recent_count <= allowable_ad_count) {
+    return false;
+  }
+
+  next_update_timestamp_in_seconds_ = std::min(
+      next_update_timestamp_in_seconds_,
+      oldest_timestamp_in_seconds + kRollingWindowInSeconds);
+
+  return true;
+}
+
+}  // namespace ads
@@ -0,0 +1,98 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_AD_ELIGIBILITY_H_
+#define BAT_ADS_INTERNAL_AD_ELIGIBILITY_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+
+#include "bat/ads/internal/serving_index.h"
+
+namespace ads {
+
+using AdHistory = std::map<std::string, std::deque<uint64_t>>;
+
+// Tracks which creative sets and campaigns of a serving index have reached
+// their caps in bitsets indexed by dense id, so that ads can be filtered
+// without looking up their history. The bitsets are rebuilt from the history
+// when the serving index changes or an impression leaves the rolling window of
+// a capped creative set or campaign, and updated when an impression is
+// recorded. Campaigns which are out of flight are tracked in another bitset
+// which is only recomputed when the next campaign starts or ends
+class AdEligibility {
+ public:
+  AdEligibility();
+  ~AdEligibility();
+
+  // Returns true if |Update| must be called before filtering ads from
+  // |serving_index|
+  bool IsStale(
+      const ServingIndex* serving_index,
+      const uint64_t now_in_seconds) const;
+
+  void Update(
+      std::shared_ptr<const ServingIndex> serving_index,
+      const AdHistory& creative_set_history,
+      const AdHistory& campaign_history,
+      const uint64_t now_in_seconds);
+
+  // Recomputes which campaigns are out of flight if a campaign has started or
+  // ended since they were last computed
+  void UpdateFlightWindows(const uint64_t now_in_seconds);
+
+  // Should be called after an impression has been appended to the history
+  void OnImpression(
+      const std::string& creative_set_id,
+      const std::string& campaign_id,
+      const AdHistory& creative_set_history,
+      const AdHistory& campaign_history,
+      const uint64_t now_in_seconds);
+
+  bool IsEligible(
+      const uint32_t creative_set,
+      const uint32_t campaign) const {
+    return !capped_creative_sets_[creative_set] &&
+        !capped_campaigns_[campaign] && !out_of_flight_campaigns_[campaign];
+  }
+
+  void Reset();
+
+ private:
+  void UpdateCreativeSet(
+      const uint32_t index,
+      const AdHistory& creative_set_history,
+      const uint64_t now_in_seconds);
+
+  void UpdateCampaign(
+      const uint32_t index,
+      const AdHistory& campaign_history,
+      const uint64_t now_in_seconds);
+
+  // Returns true if the impressions within the rolling window exceed
+  // |allowable_ad_count|, and updates |next_update_timestamp_in_seconds_| to
+  // when the oldest of those impressions leaves the window
+  bool IsCapped(
+      const std::deque<uint64_t>& history,
+      const uint64_t allowable_ad_count,
+      const uint64_t now_in_seconds);
+
+  std::shared_ptr<const ServingIndex> serving_index_;
+
+  std::vector<bool> capped_creative_sets_;
+  std::vector<bool> capped_campaigns_;
+  std::vector<bool> out_of_flight_campaigns_;
+
+  uint64_t next_update_timestamp_in_seconds_;
+  uint64_t next_flight_boundary_in_seconds_;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_AD_ELIGIBILITY_H_
@@ -0,0 +1,201 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <memory>
+#include <limits>
+
+#include "bat/ads/bundle_state.h"
+
+#include "bat/ads/internal/ad_eligibility.h"
+#include "bat/ads/internal/serving_index.h"
+#include "bat/ads/internal/time_helper.h"
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+static const uint64_t kNowInSeconds = 1000000;
+static const uint64_t kDayInSeconds =
+    base::Time::kSecondsPerHour * base::Time::kHoursPerDay;
+
+class AdEligibilityTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ServingIndex> serving_index_;
+  AdEligibility eligibility_;
+
+  uint32_t creative_set_;
+  uint32_t campaign_;
+
+  AdEligibilityTest() :
+      creative_set_(0),
+      campaign_(0) {
+    // You can do set-up work for each test here
+  }
+
+  ~AdEligibilityTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // If the constructor and destructor are not enough for setting up and
+  // cleaning up each test, you can use the following methods
+
+  void SetUp() override {
+    // Code here will be called immediately after the constructor (right before
+    // each test)
+
+    AdInfo ad;
+    ad.creative_set_id = "creative-set";
+    ad.campaign_id = "campaign";
+    ad.daily_cap = 2;
+    ad.per_day = 1;
+    ad.total_max = 3;
+    ad.regions = {"US"};
+
+    auto bundle_state = std::make_shared<BundleState>();
+    bundle_state->categories = {{"travel", {ad}}};
+
+    serving_index_ = std::make_shared<ServingIndex>(bundle_state);
+
+    ASSERT_TRUE(serving_index_->GetCreativeSetIndex("creative-set",
+        &creative_set_));
+    ASSERT_TRUE(serving_index_->GetCampaignIndex("campaign", &campaign_));
+  }
+
+  void TearDown() override {
+    // Code here will be called immediately after each test (right before the
+    // destructor)
+  }
+};
+
+TEST_F(AdEligibilityTest, Update_Eligible) {
+  // Arrange
+  AdHistory creative_set_history = {
+    {"creative-set", {kNowInSeconds - kDayInSeconds}}
+  };
+
+  // Act
+  eligibility_.Update(serving_index_, creative_set_history, {}, kNowInSeconds);
+
+  // Assert
+  EXPECT_TRUE(eligibility_.IsEligible(creative_set_, campaign_));
+  EXPECT_FALSE(eligibility_.IsStale(serving_index_.get(), kNowInSeconds));
+}
+
+TEST_F(AdEligibilityTest, Update_CapsCreativeSetAtTotalMax) {
+  // Arrange
+  AdHistory creative_set_history = {
+    {"creative-set", {0, 0, 0}}
+  };
+
+  // Act
+  eligibility_.Update(serving_index_, creative_set_history, {}, kNowInSeconds);
+
+  // Assert
+  EXPECT_FALSE(eligibility_.IsEligible(creative_set_, campaign_));
+}
+
+TEST_F(AdEligibilityTest, Update_CapsCreativeSetUntilOutsideRollingWindow) {
+  // Arrange
+  AdHistory creative_set_history = {
+    {"creative-set", {kNowInSeconds - 100, kNowInSeconds - 50}}
+  };
+
+  // Act
+  eligibility_.Update(serving_index_, creative_set_history, {}, kNowInSeconds);
+
+  // Assert
+  EXPECT_FALSE(eligibility_.IsEligible(creative_set_, campaign_));
+  EXPECT_FALSE(eligibility_.IsStale(serving_index_.get(),
+      kNowInSeconds - 100 + kDayInSeconds - 1));
+  EXPECT_TRUE(eligibility_.IsStale(serving_index_.get(),
+      kNowInSeconds - 100 + kDayInSeconds));
+}
+
+TEST_F(AdEligibilityTest, OnImpression_CapsCampaign) {
+  // Arrange
+  eligibility_.Update(serving_index_, {}, {}, kNowInSeconds);
+
+  AdHistory campaign_history = {
+    {"campaign", {kNowInSeconds, kNowInSeconds, kNowInSeconds}}
+  };
+
+  // Act
+  eligibility_.OnImpression("creative-set", "campaign", {}, campaign_history,
+      kNowInSeconds);
+
+  // Assert
+  EXPECT_FALSE(eligibility_.IsEligible(creative_set_, campaign_));
+}
+
+TEST_F(AdEligibilityTest, UpdateFlightWindows) {
+  // Arrange
+  uint64_t start_timestamp_in_seconds;
+  ASSERT_TRUE(helper::Time::FromUTCString("2019-06-01T00:00:00.000Z",
+      &start_timestamp_in_seconds));
+
+  uint64_t end_timestamp_in_seconds;
+  ASSERT_TRUE(helper::Time::FromUTCString("2019-07-01T00:00:00.000Z",
+      &end_timestamp_in_seconds));
+
+  AdInfo ad;
+  ad.creative_set_id = "creative-set";
+  ad.campaign_id = "campaign";
+  ad.start_timestamp = "2019-06-01T00:00:00.000Z";
+  ad.end_timestamp = "2019-07-01T00:00:00.000Z";
+  ad.daily_cap = 1;
+  ad.per_day = 1;
+  ad.total_max = 1;
+  ad.regions = {"US"};
+
+  auto bundle_state = std::make_shared<BundleState>();
+  bundle_state->categories = {{"travel", {ad}}};
+
+  auto serving_index = std::make_shared<ServingIndex>(bundle_state);
+
+  eligibility_.Update(serving_index, {}, {}, start_timestamp_in_seconds - 1);
+  auto is_eligible_before_start = eligibility_.IsEligible(0, 0);
+
+  // Act
+  eligibility_.UpdateFlightWindows(start_timestamp_in_seconds);
+  auto is_eligible_at_start = eligibility_.IsEligible(0, 0);
+
+  eligibility_.UpdateFlightWindows(end_timestamp_in_seconds - 1);
+  auto is_eligible_before_end = eligibility_.IsEligible(0, 0);
+
+  eligibility_.UpdateFlightWindows(end_timestamp_in_seconds);
+  auto is_eligible_at_end = eligibility_.IsEligible(0, 0);
+
+  // Assert
+  EXPECT_EQ(30 * kDayInSeconds,
+      end_timestamp_in_seconds - start_timestamp_in_seconds);
+  EXPECT_FALSE(is_eligible_before_start);
+  EXPECT_TRUE(is_eligible_at_start);
+  EXPECT_TRUE(is_eligible_before_end);
+  EXPECT_FALSE(is_eligible_at_end);
+  EXPECT_EQ(end_timestamp_in_seconds,
+      serving_index->GetNextFlightBoundary(start_timestamp_in_seconds));
+  EXPECT_EQ(std::numeric_limits<uint64_t>::max(),
+      serving_index->GetNextFlightBoundary(end_timestamp_in_seconds));
+}
+
+TEST_F(AdEligibilityTest, IsStale_ForAnotherServingIndex) {
+  // Arrange
+  eligibility_.Update(serving_index_, {}, {}, kNowInSeconds);
+
+  auto serving_index =
+      std::make_shared<ServingIndex>(std::make_shared<BundleState>());
+
+  // Act
+  auto is_stale = eligibility_.IsStale(serving_index.get(), kNowInSeconds);
+
+  // Assert
+  EXPECT_TRUE(is_stale);
+}
+
+}  // namespace ads
@@ -100,6 +100,17 @@ class MockAdsClient : public AdsClient {
       std::unique_ptr<BundleState> state,
       OnSaveCallback callback));
 
+  MOCK_METHOD1(BeginSaveBundleState, void(
+      std::unique_ptr<BundleState> state));
+
+  MOCK_METHOD1(SaveBundleStateCategories, void(
+      std::unique_ptr<BundleState> state));
+
+  MOCK_METHOD1(CommitBundleState, void(
+      OnSaveCallback callback));
+
+  MOCK_METHOD0(AbortBundleState, void());
+
   MOCK_METHOD2(Load, void(
       const std::string& name,
       OnLoadCallback callback));
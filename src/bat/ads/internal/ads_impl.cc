@@ -12,8 +12,12 @@
 #include "bat/ads/notification_info.h"
 
 #include "bat/ads/internal/ads_impl.h"
+#include "bat/ads/internal/json_helper.h"
 #include "bat/ads/internal/logging.h"
+#include "bat/ads/internal/metrics.h"
 #include "bat/ads/internal/search_providers.h"
+#include "bat/ads/internal/serving_index.h"
+#include "bat/ads/internal/trace_log.h"
 #include "bat/ads/internal/locale_helper.h"
 #include "bat/ads/internal/uri_helper.h"
 #include "bat/ads/internal/time_helper.h"
@@ -24,7 +28,6 @@
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
-#include "base/rand_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/string_split.h"
 #include "base/time/time.h"
@@ -44,6 +47,8 @@ AdsImpl::AdsImpl(AdsClient* ads_client) :
     last_shown_tab_id_(0),
     last_shown_tab_url_(""),
     page_score_cache_({}),
+    is_ad_serve_pending_(false),
+    is_pending_ad_serve_forced_(false),
     last_shown_notification_info_(NotificationInfo()),
     collect_activity_timer_id_(0),
     delivering_notifications_timer_id_(0),
@@ -52,7 +57,11 @@ AdsImpl::AdsImpl(AdsClient* ads_client) :
     client_(std::make_unique<Client>(this, ads_client)),
     bundle_(std::make_unique<Bundle>(this, ads_client)),
     ads_serve_(std::make_unique<AdsServe>(this, ads_client, bundle_.get())),
-    user_model_(nullptr),
+    user_model_cache_(std::make_unique<UserModelCache>(ads_client,
+        kUserModelCacheSize)),
+    sample_bundle_(nullptr),
+    ad_eligibility_(std::make_unique<AdEligibility>()),
+    initialization_sequencer_(std::make_unique<InitializationSequencer>()),
     is_initialized_(false),
     is_confirmations_ready_(false),
     ads_client_(ads_client) {
@@ -61,6 +70,8 @@ AdsImpl::AdsImpl(AdsClient* ads_client) :
 AdsImpl::~AdsImpl() = default;
 
 void AdsImpl::Initialize() {
+  ADS_TRACE_EVENT("AdsImpl::Initialize");
+
   if (!ads_client_->IsAdsEnabled()) {
     BLOG(INFO) << "Deinitializing as Ads are disabled";
 
@@ -74,16 +85,42 @@ void AdsImpl::Initialize() {
     return;
   }
 
-  client_->LoadState();
+  ADS_TRACE_ASYNC_BEGIN("AdsImpl::Initialize", this);
+
+  // The catalog response is not processed until Ads are initialized. The
+  // download waits for the client state so that the bundle can be restored
+  // from the saved metadata and the catalog requested conditionally, in which
+  // case ads can be served as soon as Ads are initialized and the catalog is
+  // not downloaded again if it has not been modified, see
+  // |Bundle::ShouldRebuildFromCatalog|. The user model is not loaded until it
+  // is first needed, see |GetUserModel|
+  ads_serve_->PauseCatalogProcessing();
+
+  initialization_sequencer_->Reset();
+  initialization_sequencer_->AddStep(LOAD_CLIENT_STATE_STEP, {},
+      std::bind(&Client::LoadState, client_.get()));
+  initialization_sequencer_->AddStep(DOWNLOAD_CATALOG_STEP,
+      {LOAD_CLIENT_STATE_STEP},
+      std::bind(&AdsServe::DownloadCatalog, ads_serve_.get()));
+  initialization_sequencer_->AddStep(INITIALIZE_STEP,
+      {LOAD_CLIENT_STATE_STEP},
+      std::bind(&AdsImpl::InitializeStep3, this));
+  initialization_sequencer_->Start();
 }
 
 void AdsImpl::InitializeStep2() {
+  ADS_TRACE_EVENT("AdsImpl::InitializeStep2");
+
   client_->SetLocales(ads_client_->GetLocales());
 
-  LoadUserModel();
+  bundle_->RestoreFromMetadata(client_->GetBundleMetadata());
+
+  initialization_sequencer_->CompleteStep(LOAD_CLIENT_STATE_STEP);
 }
 
 void AdsImpl::InitializeStep3() {
+  ADS_TRACE_EVENT("AdsImpl::InitializeStep3");
+
   is_initialized_ = true;
 
   BLOG(INFO) << "Successfully initialized";
@@ -100,7 +137,9 @@ void AdsImpl::InitializeStep3() {
 
   ConfirmAdUUIDIfAdEnabled();
 
-  ads_serve_->DownloadCatalog();
+  ads_serve_->ResumeCatalogProcessing();
+
+  ADS_TRACE_ASYNC_END("AdsImpl::Initialize", this);
 }
 
 void AdsImpl::Deinitialize() {
@@ -112,6 +151,8 @@ void AdsImpl::Deinitialize() {
 
   BLOG(INFO) << "Deinitializing";
 
+  initialization_sequencer_->Reset();
+
   ads_serve_->Reset();
 
   StopDeliveringNotifications();
@@ -121,7 +162,11 @@ void AdsImpl::Deinitialize() {
   RemoveAllHistory();
 
   bundle_->Reset();
-  user_model_.reset();
+  user_model_cache_->Clear();
+  pages_to_classify_.clear();
+  is_ad_serve_pending_ = false;
+  is_pending_ad_serve_forced_ = false;
+  sample_bundle_.reset();
 
   last_shown_notification_info_ = NotificationInfo();
 
@@ -134,45 +179,38 @@ void AdsImpl::Deinitialize() {
 
 bool AdsImpl::IsInitialized() {
   if (!is_initialized_ ||
-      !ads_client_->IsAdsEnabled() ||
-      !user_model_->IsInitialized()) {
+      !ads_client_->IsAdsEnabled()) {
     return false;
   }
 
   return true;
 }
 
-void AdsImpl::LoadUserModel() {
-  auto locale = client_->GetLocale();
-  auto callback = std::bind(&AdsImpl::OnUserModelLoaded, this, _1, _2);
-  ads_client_->LoadUserModelForLocale(locale, callback);
+usermodel::UserModel* AdsImpl::GetUserModel() {
+  auto callback = std::bind(&AdsImpl::OnUserModelLoaded, this, _1);
+  return user_model_cache_->Get(client_->GetLocale(), callback);
 }
 
-void AdsImpl::OnUserModelLoaded(const Result result, const std::string& json) {
+void AdsImpl::OnUserModelLoaded(const Result result) {
   if (result != SUCCESS) {
-    BLOG(ERROR) << "Failed to load user model";
+    BLOG(ERROR) << "Failed to load user model, dropped "
+        << pages_to_classify_.size() << " pages to classify";
 
-    return;
-  }
+    pages_to_classify_.clear();
 
-  BLOG(INFO) << "Successfully loaded user model";
+    if (is_ad_serve_pending_) {
+      BLOG(INFO) << "Notification not made: User model failed to load";
 
-  InitializeUserModel(json);
+      is_ad_serve_pending_ = false;
+      is_pending_ad_serve_forced_ = false;
+    }
 
-  if (!IsInitialized()) {
-    InitializeStep3();
+    return;
   }
-}
-
-void AdsImpl::InitializeUserModel(const std::string& json) {
-  // TODO(Terry Mancey): Refactor function to use callbacks
-
-  BLOG(INFO) << "Initializing user model";
 
-  user_model_.reset(usermodel::UserModel::CreateInstance());
-  user_model_->InitializePageClassifier(json);
+  ClassifyPendingPages();
 
-  BLOG(INFO) << "Initialized user model";
+  ServePendingAd();
 }
 
 bool AdsImpl::IsMobile() const {
@@ -300,6 +338,7 @@ void AdsImpl::TabClosed(const int32_t tab_id) {
 
 void AdsImpl::RemoveAllHistory() {
   client_->RemoveAllHistory();
+  ad_eligibility_->Reset();
 
   ConfirmAdUUIDIfAdEnabled();
 }
@@ -337,35 +376,59 @@ void AdsImpl::SetConfirmationsIsReady(const bool is_ready) {
   is_confirmations_ready_ = is_ready;
 }
 
+std::unique_ptr<DiagnosticsInfo> AdsImpl::GetDiagnostics() {
+#if defined(BAT_ADS_ENABLE_METRICS)
+  return Metrics::GetInstance()->GetDiagnostics();
+#else
+  return std::make_unique<DiagnosticsInfo>();
+#endif
+}
+
+std::string AdsImpl::GetTraceEvents() {
+  return TraceLog::GetInstance()->ToJson();
+}
+
 void AdsImpl::ChangeLocale(const std::string& locale) {
   if (!IsInitialized()) {
     return;
   }
 
-  auto locales = ads_client_->GetLocales();
-
-  if (std::find(locales.begin(), locales.end(), locale) != locales.end()) {
+  auto closest_match_for_locale = GetClosestMatchForLocale(locale);
+  if (closest_match_for_locale == locale) {
     BLOG(INFO) << "Change Localed to " << locale;
-    client_->SetLocale(locale);
   } else {
-    std::string closest_match_for_locale = "";
-    auto language_code = helper::Locale::GetLanguageCode(locale);
-    if (std::find(locales.begin(), locales.end(),
-        language_code) != locales.end()) {
-      closest_match_for_locale = language_code;
-    } else {
-      closest_match_for_locale = kDefaultLanguageCode;
-    }
-
     BLOG(INFO) << "Locale not found, so changed Locale to closest match: "
         << closest_match_for_locale;
-    client_->SetLocale(closest_match_for_locale);
   }
 
-  LoadUserModel();
+  client_->SetLocale(closest_match_for_locale);
+
+  sample_bundle_.reset();
+
+  // The user model for the new locale is loaded when it is next needed unless
+  // it is still cached, see |GetUserModel|
+}
+
+std::string AdsImpl::GetClosestMatchForLocale(const std::string& locale) {
+  auto locales = ads_client_->GetLocales();
+
+  if (std::find(locales.begin(), locales.end(), locale) != locales.end()) {
+    return locale;
+  }
+
+  auto language_code = helper::Locale::GetLanguageCode(locale);
+  if (std::find(locales.begin(), locales.end(),
+      language_code) != locales.end()) {
+    return language_code;
+  }
+
+  return kDefaultLanguageCode;
 }
 
 void AdsImpl::ClassifyPage(const std::string& url, const std::string& html) {
+  ADS_METRICS_SCOPED_TIMER(CLASSIFY_PAGE_HISTOGRAM);
+  ADS_TRACE_EVENT("AdsImpl::ClassifyPage");
+
   if (!IsInitialized()) {
     BLOG(INFO) << "Site visited " << url << ", not initialized";
 
@@ -394,8 +457,36 @@ void AdsImpl::ClassifyPage(const std::string& url, const std::string& html) {
 
   TestShoppingData(url);
 
-  auto page_score = user_model_->ClassifyPage(html);
-  auto winning_category = GetWinningCategory(page_score);
+  auto* user_model = GetUserModel();
+  if (!user_model) {
+    if (!user_model_cache_->IsLoading(client_->GetLocale())) {
+      BLOG(WARNING) << "Site visited " << url
+          << ", user model failed to load";
+
+      return;
+    }
+
+    if (pages_to_classify_.size() >=
+        kMaximumPagesToClassifyWhileLoadingUserModel) {
+      pages_to_classify_.pop_front();
+    }
+
+    pages_to_classify_.emplace_back(url, html);
+
+    BLOG(INFO) << "Site visited " << url << ", user model is loading";
+
+    return;
+  }
+
+  ClassifyPageWithUserModel(user_model, url, html);
+}
+
+void AdsImpl::ClassifyPageWithUserModel(
+    usermodel::UserModel* user_model,
+    const std::string& url,
+    const std::string& html) {
+  auto page_score = user_model->ClassifyPage(html);
+  auto winning_category = user_model->WinningCategory(page_score);
   if (winning_category.empty()) {
     BLOG(INFO) << "Site visited " << url
         << ", not enough content to classify page";
@@ -428,6 +519,21 @@ void AdsImpl::ClassifyPage(const std::string& url, const std::string& html) {
   }
 }
 
+void AdsImpl::ClassifyPendingPages() {
+  while (!pages_to_classify_.empty()) {
+    auto* user_model = GetUserModel();
+    if (!user_model) {
+      // The locale changed while the user model was loading
+      return;
+    }
+
+    auto page = std::move(pages_to_classify_.front());
+    pages_to_classify_.pop_front();
+
+    ClassifyPageWithUserModel(user_model, page.first, page.second);
+  }
+}
+
 std::string AdsImpl::GetWinnerOverTimeCategory() {
   auto page_score_history = client_->GetPageScoreHistory();
   if (page_score_history.size() == 0) {
@@ -455,12 +561,22 @@ std::string AdsImpl::GetWinnerOverTimeCategory() {
 
 std::string AdsImpl::GetWinningCategory(
     const std::vector<double>& page_score) {
-  return user_model_->WinningCategory(page_score);
+  auto* user_model = GetUserModel();
+  if (!user_model) {
+    return "";
+  }
+
+  return user_model->WinningCategory(page_score);
 }
 
 std::string AdsImpl::GetWinningCategory(const std::string& html) {
-  auto page_score = user_model_->ClassifyPage(html);
-  return GetWinningCategory(page_score);
+  auto* user_model = GetUserModel();
+  if (!user_model) {
+    return "";
+  }
+
+  auto page_score = user_model->ClassifyPage(html);
+  return user_model->WinningCategory(page_score);
 }
 
 void AdsImpl::CachePageScore(
@@ -508,10 +624,30 @@ void AdsImpl::ServeSampleAd() {
     return;
   }
 
+  if (sample_bundle_) {
+    ServeSampleAdFromSampleBundle();
+    return;
+  }
+
   auto callback = std::bind(&AdsImpl::OnLoadSampleBundle, this, _1, _2);
   ads_client_->LoadSampleBundle(callback);
 }
 
+void AdsImpl::ServeSampleAdFromSampleBundle() {
+  std::string category;
+  auto* ad = sample_bundle_->GetRandomAd(&category);
+  if (!ad) {
+    // TODO(Terry Mancey): Implement Log (#44)
+    // 'Notification not made', { reason: 'no categories' }
+
+    BLOG(INFO) << "Notification not made: No sample bundle ads";
+
+    return;
+  }
+
+  ShowAd(*ad, category);
+}
+
 void AdsImpl::OnLoadSampleBundle(
     const Result result,
     const std::string& json) {
@@ -529,49 +665,16 @@ void AdsImpl::OnLoadSampleBundle(
   auto json_result = state.FromJson(json, json_schema, &error_description);
   if (json_result != SUCCESS) {
     BLOG(ERROR) << "Failed to parse sample bundle (" << error_description
-        << "): " << json;
-
-    return;
-  }
-
-  // TODO(Terry Mancey): Sample bundle state should be persisted on the Client
-  // in a database so that sample ads can be fetched from the database rather
-  // than parsing the JSON each time, and be consistent with GetAds, therefore
-  // the below code should be abstracted into GetAdForSampleCategory once the
-  // necessary changes have been made in Brave Core by Brian Johnson
-
-  auto categories = state.categories.begin();
-  auto categories_count = state.categories.size();
-  if (categories_count == 0) {
-    // TODO(Terry Mancey): Implement Log (#44)
-    // 'Notification not made', { reason: 'no categories' }
-
-    BLOG(INFO) << "Notification not made: No sample bundle categories";
-
-    return;
-  }
-
-  auto category_rand = base::RandInt(0, categories_count - 1);
-  std::advance(categories, static_cast<int64_t>(category_rand));
-
-  auto category = categories->first;
-  auto ads = categories->second;
-
-  auto ads_count = ads.size();
-  if (ads_count == 0) {
-    // TODO(Terry Mancey): Implement Log (#44)
-    // 'Notification not made', { reason: 'no ads for category', category }
-
-    BLOG(INFO) << "Notification not made: No sample bundle ads found for \""
-        << category << "\" sample category";
+        << "): " << helper::JSON::GetSummary(json);
 
     return;
   }
 
-  auto ad_rand = base::RandInt(0, ads_count - 1);
-  auto ad = ads.at(ad_rand);
+  // The sample bundle is only parsed once, subsequent sample ads are picked
+  // from the indexed sample bundle until the locale changes
+  sample_bundle_ = std::make_unique<SampleBundle>(std::move(state.categories));
 
-  ShowAd(ad, category);
+  ServeSampleAdFromSampleBundle();
 }
 
 void AdsImpl::CheckEasterEgg(const std::string& url) {
@@ -637,15 +740,49 @@ void AdsImpl::CheckReadyAdServe(const bool forced) {
     }
   }
 
+  if (!GetUserModel()) {
+    if (!user_model_cache_->IsLoading(client_->GetLocale())) {
+      BLOG(INFO) << "Notification not made: User model failed to load";
+
+      return;
+    }
+
+    // The category is picked by the user model, so the serve is retried once
+    // the user model has loaded rather than served from an empty category
+    is_ad_serve_pending_ = true;
+    is_pending_ad_serve_forced_ = is_pending_ad_serve_forced_ || forced;
+
+    BLOG(INFO) << "Notification not made: User model is loading";
+
+    return;
+  }
+
   auto category = GetWinnerOverTimeCategory();
   ServeAdFromCategory(category);
 }
 
+void AdsImpl::ServePendingAd() {
+  if (!is_ad_serve_pending_) {
+    return;
+  }
+
+  auto forced = is_pending_ad_serve_forced_;
+
+  is_ad_serve_pending_ = false;
+  is_pending_ad_serve_forced_ = false;
+
+  CheckReadyAdServe(forced);
+}
+
 void AdsImpl::ServeAdFromCategory(const std::string& category) {
+  ADS_TRACE_EVENT("AdsImpl::ServeAdFromCategory");
+
   BLOG(INFO) << "Notification for category " << category;
 
-  std::string catalog_id = bundle_->GetCatalogId();
-  if (catalog_id.empty()) {
+  // Pin the serving index so that the serve sees a consistent bundle if the
+  // catalog is updated in the meantime
+  auto serving_index = bundle_->GetServingIndex();
+  if (serving_index->GetBundleState()->catalog_id.empty()) {
     // TODO(Terry Mancey): Implement Log (#44)
     // 'Notification not made', { reason: 'no ad catalog' }
 
@@ -667,8 +804,65 @@ void AdsImpl::ServeAdFromCategory(const std::string& category) {
   auto locale = ads_client_->GetAdsLocale();
   auto region = helper::Locale::GetCountryCode(locale);
 
-  auto callback = std::bind(&AdsImpl::OnGetAds, this, _1, _2, _3, _4);
-  ads_client_->GetAds(region, category, callback);
+  if (!bundle_->HasCategoriesInMemory()) {
+    // Categories are not kept in memory on mobile or until the bundle has been
+    // updated from a catalog after restoring it on startup, see |Bundle|
+    auto callback = std::bind(&AdsImpl::OnGetAds, this, _1, _2, _3, _4);
+    ads_client_->GetAds(region, category, callback);
+    return;
+  }
+
+  ServeAdFromServingIndex(serving_index, region, category);
+}
+
+void AdsImpl::ServeAdFromServingIndex(
+    std::shared_ptr<const ServingIndex> serving_index,
+    const std::string& region,
+    const std::string& category) {
+  auto ads_category = category;
+
+  while (!serving_index->HasAds(region, ads_category)) {
+    auto pos = ads_category.find_last_of('-');
+    if (pos == std::string::npos) {
+      // TODO(Terry Mancey): Implement Log (#44)
+      // 'Notification not made', { reason: 'no ads for category', category }
+
+      BLOG(INFO) << "Notification not made: No ads found in \""
+          << ads_category << "\" category for " << region << " region";
+
+      return;
+    }
+
+    std::string new_category = ads_category.substr(0, pos);
+
+    BLOG(INFO) << "Notification not made: No ads found in \"" << ads_category
+        << "\" category for " << region << " region, trying again with \""
+        << new_category << "\" category";
+
+    ads_category = new_category;
+  }
+
+  auto now_in_seconds = helper::Time::NowInSeconds();
+  if (ad_eligibility_->IsStale(serving_index.get(), now_in_seconds)) {
+    ad_eligibility_->Update(serving_index, client_->GetCreativeSetHistory(),
+        client_->GetCampaignHistory(), now_in_seconds);
+  }
+
+  ad_eligibility_->UpdateFlightWindows(now_in_seconds);
+
+  auto* ad = serving_index->SelectAd(region, ads_category, *ad_eligibility_);
+  if (!ad) {
+    // TODO(Terry Mancey): Implement Log (#44)
+    // 'Notification not made', { reason: 'no ad (or permitted ad) for
+    // winnerOverTime', category, winnerOverTime, arbitraryKey }
+
+    BLOG(INFO) << "Notification not made: No ad (or permitted ad) for \""
+        << ads_category << "\" category";
+
+    return;
+  }
+
+  ShowAd(*ad, ads_category);
 }
 
 void AdsImpl::OnGetAds(
@@ -715,50 +909,67 @@ void AdsImpl::OnGetAds(
     return;
   }
 
-  auto rand = base::RandInt(0, ads_unseen.size() - 1);
-  auto ad = ads_unseen.at(rand);
-  ShowAd(ad, category);
+  auto* ad = ServingIndex::SelectWeightedAd(ads_unseen);
+  ShowAd(*ad, category);
 }
 
 std::vector<AdInfo> AdsImpl::GetUnseenAds(
     const std::vector<AdInfo>& ads) {
+  ADS_METRICS_SCOPED_TIMER(GET_UNSEEN_ADS_HISTOGRAM);
+
   std::vector<AdInfo> ads_unseen = {};
 
   for (const auto& ad : ads) {
-    std::deque<uint64_t> creative_set = {};
-    auto creative_set_history = client_->GetCreativeSetHistory();
-    if (creative_set_history.find(ad.creative_set_id)
-        != creative_set_history.end()) {
-      creative_set = creative_set_history.at(ad.creative_set_id);
-    }
-
-    if (creative_set.size() >= ad.total_max) {
+    if (!IsAdEligible(ad)) {
       continue;
     }
 
-    auto day_window = base::Time::kSecondsPerHour * base::Time::kHoursPerDay;
+    ads_unseen.push_back(ad);
+  }
 
-    if (!HistoryRespectsRollingTimeConstraint(
-        creative_set, day_window, ad.per_day)) {
-      continue;
-    }
+  return ads_unseen;
+}
 
-    std::deque<uint64_t> campaign = {};
-    auto campaign_history = client_->GetCampaignHistory();
-    if (campaign_history.find(ad.campaign_id)
-        != campaign_history.end()) {
-      campaign = campaign_history.at(ad.campaign_id);
-    }
+bool AdsImpl::IsAdEligible(const AdInfo& ad) {
+  if (!IsAdInFlight(ad)) {
+    return false;
+  }
 
-    if (!HistoryRespectsRollingTimeConstraint(
-        campaign, day_window, ad.daily_cap)) {
-      continue;
-    }
+  std::deque<uint64_t> creative_set = {};
+  const auto& creative_set_history = client_->GetCreativeSetHistory();
+  if (creative_set_history.find(ad.creative_set_id)
+      != creative_set_history.end()) {
+    creative_set = creative_set_history.at(ad.creative_set_id);
+  }
 
-    ads_unseen.push_back(ad);
+  if (creative_set.size() >= ad.total_max) {
+    return false;
   }
 
-  return ads_unseen;
+  auto day_window = base::Time::kSecondsPerHour * base::Time::kHoursPerDay;
+
+  if (!HistoryRespectsRollingTimeConstraint(
+      creative_set, day_window, ad.per_day)) {
+    return false;
+  }
+
+  std::deque<uint64_t> campaign = {};
+  const auto& campaign_history = client_->GetCampaignHistory();
+  if (campaign_history.find(ad.campaign_id)
+      != campaign_history.end()) {
+    campaign = campaign_history.at(ad.campaign_id);
+  }
+
+  if (!HistoryRespectsRollingTimeConstraint(
+      campaign, day_window, ad.daily_cap)) {
+    return false;
+  }
+
+  return true;
+}
+
+bool AdsImpl::IsAdInFlight(const AdInfo& ad) const {
+  return bundle_->IsAdInFlight(ad, helper::Time::NowInSeconds());
 }
 
 bool AdsImpl::IsAdValid(const AdInfo& ad_info) {
@@ -786,6 +997,9 @@ bool AdsImpl::IsAdValid(const AdInfo& ad_info) {
 bool AdsImpl::ShowAd(
     const AdInfo& ad_info,
     const std::string& category) {
+  ADS_METRICS_SCOPED_TIMER(SHOW_AD_HISTOGRAM);
+  ADS_TRACE_EVENT("AdsImpl::ShowAd");
+
   if (!IsAdValid(ad_info)) {
     return false;
   }
@@ -814,11 +1028,16 @@ bool AdsImpl::ShowAd(
       << std::endl << "  uuid: " << notification_info->uuid;
 
   ads_client_->ShowNotification(std::move(notification_info));
+  ADS_METRICS_INCREMENT(ADS_SHOWN_COUNTER, 1);
 
   client_->AppendCurrentTimeToAdsShownHistory();
   client_->AppendCurrentTimeToCreativeSetHistory(ad_info.creative_set_id);
   client_->AppendCurrentTimeToCampaignHistory(ad_info.campaign_id);
 
+  ad_eligibility_->OnImpression(ad_info.creative_set_id, ad_info.campaign_id,
+      client_->GetCreativeSetHistory(), client_->GetCampaignHistory(),
+      helper::Time::NowInSeconds());
+
   return true;
 }
 
@@ -972,6 +1191,7 @@ bool AdsImpl::IsCatalogOlderThanOneDay() {
 }
 
 void AdsImpl::BundleUpdated() {
+  ads_serve_->SaveCatalogValidators();
   ads_serve_->UpdateNextCatalogCheck();
 }
 
@@ -1096,13 +1316,13 @@ bool AdsImpl::IsStillViewingAd() const {
 
 void AdsImpl::OnTimer(const uint32_t timer_id) {
   BLOG(INFO) << "OnTimer: " << std::endl
-      << "  timer_id: " << std::to_string(timer_id) << std::endl
-      << "  collect_activity_timer_id_: "
-      << std::to_string(collect_activity_timer_id_) << std::endl
+      << "  timer_id: " << timer_id << std::endl
+      << "  collect_activity_timer_id_: " << collect_activity_timer_id_
+      << std::endl
       << "  deliverying_notifications_timer_id_: "
-      << std::to_string(delivering_notifications_timer_id_) << std::endl
+      << delivering_notifications_timer_id_ << std::endl
       << "  sustained_ad_interaction_timer_id_: "
-      << std::to_string(sustained_ad_interaction_timer_id_);
+      << sustained_ad_interaction_timer_id_;
   if (timer_id == collect_activity_timer_id_) {
     CollectActivity();
   } else if (timer_id == delivering_notifications_timer_id_) {
@@ -1110,7 +1330,7 @@ void AdsImpl::OnTimer(const uint32_t timer_id) {
   } else if (timer_id == sustained_ad_interaction_timer_id_) {
     SustainAdInteractionIfNeeded();
   } else {
-    BLOG(WARNING) << "Unexpected OnTimer: " << std::to_string(timer_id);
+    BLOG(WARNING) << "Unexpected OnTimer: " << timer_id;
   }
 }
 
@@ -12,12 +12,14 @@
 #include <vector>
 #include <deque>
 #include <memory>
+#include <utility>
 
 #include "bat/ads/ads.h"
 #include "bat/ads/ad_info.h"
 #include "bat/ads/notification_result_type.h"
 #include "bat/ads/notification_info.h"
 
+#include "bat/ads/internal/ad_eligibility.h"
 #include "bat/ads/internal/ads_serve.h"
 #include "bat/ads/internal/event_type_blur_info.h"
 #include "bat/ads/internal/event_type_destroy_info.h"
@@ -25,6 +27,9 @@
 #include "bat/ads/internal/event_type_load_info.h"
 #include "bat/ads/internal/client.h"
 #include "bat/ads/internal/bundle.h"
+#include "bat/ads/internal/initialization_sequencer.h"
+#include "bat/ads/internal/sample_bundle.h"
+#include "bat/ads/internal/user_model_cache.h"
 
 #include "bat/usermodel/user_model.h"
 
@@ -32,6 +37,7 @@ namespace ads {
 
 class Client;
 class Bundle;
+class ServingIndex;
 class AdsServe;
 
 class AdsImpl : public Ads {
@@ -47,9 +53,10 @@ class AdsImpl : public Ads {
   void Deinitialize();
   bool IsInitialized();
 
-  void LoadUserModel();
-  void OnUserModelLoaded(const Result result, const std::string& json);
-  void InitializeUserModel(const std::string& json);
+  // Returns the user model for the current locale, or nullptr if it is still
+  // loading, see |UserModelCache::Get|
+  usermodel::UserModel* GetUserModel();
+  void OnUserModelLoaded(const Result result);
 
   bool IsMobile() const;
 
@@ -83,9 +90,23 @@ class AdsImpl : public Ads {
 
   void SetConfirmationsIsReady(const bool is_ready) override;
 
+  std::unique_ptr<DiagnosticsInfo> GetDiagnostics() override;
+
+  std::string GetTraceEvents() override;
+
   void ChangeLocale(const std::string& locale) override;
+  std::string GetClosestMatchForLocale(const std::string& locale);
 
   void ClassifyPage(const std::string& url, const std::string& html) override;
+  void ClassifyPageWithUserModel(
+      usermodel::UserModel* user_model,
+      const std::string& url,
+      const std::string& html);
+
+  // Pages, as URL and HTML pairs, which were visited while the user model was
+  // loading and are classified once it has loaded
+  std::deque<std::pair<std::string, std::string>> pages_to_classify_;
+  void ClassifyPendingPages();
   std::string GetWinnerOverTimeCategory();
   std::string GetWinningCategory(const std::vector<double>& page_score);
   std::string GetWinningCategory(const std::string& html);
@@ -99,19 +120,33 @@ class AdsImpl : public Ads {
   bool TestSearchState(const std::string& url);
 
   void ServeSampleAd() override;
+  void ServeSampleAdFromSampleBundle();
   void OnLoadSampleBundle(
       const Result result,
       const std::string& json);
 
   void CheckEasterEgg(const std::string& url);
   void CheckReadyAdServe(const bool forced);
+
+  // Whether an ad serve was requested while the user model was loading, in
+  // which case the serve is retried once it has loaded, see |ServePendingAd|
+  bool is_ad_serve_pending_;
+  bool is_pending_ad_serve_forced_;
+  void ServePendingAd();
+
   void ServeAdFromCategory(const std::string& category);
+  void ServeAdFromServingIndex(
+      std::shared_ptr<const ServingIndex> serving_index,
+      const std::string& region,
+      const std::string& category);
   void OnGetAds(
       const Result result,
       const std::string& region,
       const std::string& category,
       const std::vector<AdInfo>& ads);
   std::vector<AdInfo> GetUnseenAds(const std::vector<AdInfo>& ads);
+  bool IsAdEligible(const AdInfo& ad);
+  bool IsAdInFlight(const AdInfo& ad) const;
   bool IsAdValid(const AdInfo& ad_info);
   NotificationInfo last_shown_notification_info_;
   bool ShowAd(const AdInfo& ad_info, const std::string& category);
@@ -168,7 +203,14 @@ class AdsImpl : public Ads {
   std::unique_ptr<Client> client_;
   std::unique_ptr<Bundle> bundle_;
   std::unique_ptr<AdsServe> ads_serve_;
-  std::unique_ptr<usermodel::UserModel> user_model_;
+  std::unique_ptr<UserModelCache> user_model_cache_;
+
+  // Loaded on the first sample ad and kept until the locale changes
+  std::unique_ptr<SampleBundle> sample_bundle_;
+
+  std::unique_ptr<AdEligibility> ad_eligibility_;
+
+  std::unique_ptr<InitializationSequencer> initialization_sequencer_;
 
  private:
   bool is_initialized_;
@@ -0,0 +1,332 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <string>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "bat/ads/bundle_state.h"
+#include "bat/ads/notification_info.h"
+
+#include "bat/ads/internal/ad_eligibility.h"
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/ads_impl.h"
+#include "bat/ads/internal/client.h"
+#include "bat/ads/internal/serving_index.h"
+#include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/test_data_helper.h"
+#include "bat/usermodel/user_model.h"
+
+#include "base/time/time.h"
+#include "base/time/time_override.h"
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace ads {
+
+namespace {
+
+// 2019-06-01T00:00:00Z, the ads in test/data/catalog.json are in flight at
+// this time so that serving measures selecting ads rather than rejecting them
+const double kNowInSeconds = 1559347200;
+
+base::Time Now() {
+  return base::Time::FromDoubleT(kNowInSeconds);
+}
+
+// Initializes an |AdsImpl| against a mock client which loads state from
+// test/data and the user model from resources, as the unit tests do, with the
+// clock pinned to |kNowInSeconds|
+class AdsImplBenchmark {
+ public:
+  AdsImplBenchmark() :
+      time_overrides_(std::make_unique<base::subtle::ScopedTimeClockOverrides>(
+          &Now, nullptr, nullptr)),
+      mock_ads_client_(std::make_unique<NiceMock<MockAdsClient>>()),
+      ads_(std::make_unique<AdsImpl>(mock_ads_client_.get())) {
+    ON_CALL(*mock_ads_client_, IsAdsEnabled())
+        .WillByDefault(Return(true));
+
+    ON_CALL(*mock_ads_client_, Load(_, _))
+        .WillByDefault(
+            Invoke([](
+                const std::string& name,
+                OnLoadCallback callback) {
+              auto value = helper::TestData::Load(name);
+              callback(value.empty() ? FAILED : SUCCESS, value);
+            }));
+
+    ON_CALL(*mock_ads_client_, Save(_, _, _))
+        .WillByDefault(
+            Invoke([](
+                const std::string& name,
+                const std::string& value,
+                OnSaveCallback callback) {
+              callback(SUCCESS);
+            }));
+
+    ON_CALL(*mock_ads_client_, LoadUserModelForLocale(_, _))
+        .WillByDefault(
+            Invoke([](
+                const std::string& locale,
+                OnLoadCallback callback) {
+              auto value = helper::TestData::LoadResource(
+                  "locales/" + locale + "/user_model.json");
+              callback(value.empty() ? FAILED : SUCCESS, value);
+            }));
+
+    ON_CALL(*mock_ads_client_, LoadJsonSchema(_))
+        .WillByDefault(
+            Invoke([](
+                const std::string& name) -> std::string {
+              return helper::TestData::LoadResource(name);
+            }));
+
+    ads_->Initialize();
+  }
+
+  ~AdsImplBenchmark() = default;
+
+  AdsImpl* ads() const {
+    return ads_.get();
+  }
+
+ private:
+  std::unique_ptr<base::subtle::ScopedTimeClockOverrides> time_overrides_;
+  std::unique_ptr<NiceMock<MockAdsClient>> mock_ads_client_;
+  std::unique_ptr<AdsImpl> ads_;
+};
+
+std::vector<AdInfo> GetAds(const BundleState& bundle_state) {
+  std::vector<AdInfo> ads;
+
+  for (const auto& category : bundle_state.categories) {
+    ads.insert(ads.end(), category.second.begin(), category.second.end());
+  }
+
+  return ads;
+}
+
+NotificationInfo GetNotificationInfo() {
+  NotificationInfo info;
+  info.creative_set_id = "creative-set-id";
+  info.category = "Technology & Computing-Software";
+  info.advertiser = "Brave";
+  info.text = "Brave is the fastest, most secure browser";
+  info.url = "https://brave.com";
+  info.uuid = "uuid";
+  return info;
+}
+
+void BM_GetUnseenAds(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+  auto bundle_state = helper::TestData::GetBundleState(state.range(0));
+  auto ads = GetAds(*bundle_state);
+
+  if (benchmark.ads()->GetUnseenAds(ads).empty()) {
+    state.SkipWithError("No unseen ads, all ads were rejected");
+    return;
+  }
+
+  for (auto _ : state) {
+    auto unseen_ads = benchmark.ads()->GetUnseenAds(ads);
+    benchmark::DoNotOptimize(unseen_ads);
+  }
+
+  state.SetItemsProcessed(state.iterations() * ads.size());
+}
+BENCHMARK(BM_GetUnseenAds)
+    ->Arg(1)->Arg(10)->Arg(100);
+
+void BM_SelectAdFromServingIndex(benchmark::State& state) {
+  std::shared_ptr<const BundleState> bundle_state =
+      helper::TestData::GetBundleState(state.range(0));
+  auto serving_index = std::make_shared<ServingIndex>(bundle_state);
+
+  AdEligibility eligibility;
+  eligibility.Update(serving_index, {}, {},
+      static_cast<uint64_t>(kNowInSeconds));
+
+  std::vector<std::pair<std::string, std::string>> keys;
+  for (const auto& category : bundle_state->categories) {
+    for (const auto& ad : category.second) {
+      for (const auto& region : ad.regions) {
+        keys.push_back({region, category.first});
+      }
+    }
+  }
+
+  if (keys.empty()) {
+    state.SkipWithError("No ads to select from");
+    return;
+  }
+
+  for (const auto& key : keys) {
+    if (!serving_index->SelectAd(key.first, key.second, eligibility)) {
+      state.SkipWithError("Failed to select ad, all ads were rejected");
+      return;
+    }
+  }
+
+  size_t index = 0;
+  for (auto _ : state) {
+    const auto& key = keys.at(index % keys.size());
+    auto* ad = serving_index->SelectAd(key.first, key.second, eligibility);
+    benchmark::DoNotOptimize(ad);
+    index++;
+  }
+}
+BENCHMARK(BM_SelectAdFromServingIndex)
+    ->Arg(1)->Arg(10)->Arg(100);
+
+void BM_GetWinnerOverTimeCategory(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+  auto* ads = benchmark.ads();
+  auto* user_model = ads->GetUserModel();
+  if (!user_model) {
+    state.SkipWithError("Failed to load user model");
+    return;
+  }
+
+  auto page_score = user_model->ClassifyPage(
+      "<html><body>The fastest, most secure browser</body></html>");
+  for (uint64_t i = 0; i < kMaximumEntriesInPageScoreHistory; i++) {
+    ads->client_->AppendPageScoreToPageScoreHistory(page_score);
+  }
+
+  for (auto _ : state) {
+    auto category = ads->GetWinnerOverTimeCategory();
+    benchmark::DoNotOptimize(category);
+  }
+}
+BENCHMARK(BM_GetWinnerOverTimeCategory);
+
+void BM_GenerateAdReportingNotificationShownEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+  auto info = GetNotificationInfo();
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingNotificationShownEvent(info);
+  }
+}
+BENCHMARK(BM_GenerateAdReportingNotificationShownEvent);
+
+void BM_GenerateAdReportingNotificationResultEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+  auto info = GetNotificationInfo();
+  auto type = static_cast<NotificationResultInfoResultType>(state.range(0));
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingNotificationResultEvent(info, type);
+  }
+}
+BENCHMARK(BM_GenerateAdReportingNotificationResultEvent)
+    ->Arg(CLICKED)->Arg(DISMISSED)->Arg(TIMEOUT);
+
+void BM_GenerateAdReportingSustainEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+  auto info = GetNotificationInfo();
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingSustainEvent(info);
+  }
+}
+BENCHMARK(BM_GenerateAdReportingSustainEvent);
+
+void BM_GenerateAdReportingLoadEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  LoadInfo info;
+  info.tab_id = 1;
+  info.tab_url = "https://brave.com";
+  info.tab_classification = "technology & computing-software";
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingLoadEvent(info);
+  }
+}
+BENCHMARK(BM_GenerateAdReportingLoadEvent);
+
+void BM_GenerateAdReportingBackgroundEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingBackgroundEvent();
+  }
+}
+BENCHMARK(BM_GenerateAdReportingBackgroundEvent);
+
+void BM_GenerateAdReportingForegroundEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingForegroundEvent();
+  }
+}
+BENCHMARK(BM_GenerateAdReportingForegroundEvent);
+
+void BM_GenerateAdReportingBlurEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  BlurInfo info;
+  info.tab_id = 1;
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingBlurEvent(info);
+  }
+}
+BENCHMARK(BM_GenerateAdReportingBlurEvent);
+
+void BM_GenerateAdReportingDestroyEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  DestroyInfo info;
+  info.tab_id = 1;
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingDestroyEvent(info);
+  }
+}
+BENCHMARK(BM_GenerateAdReportingDestroyEvent);
+
+void BM_GenerateAdReportingFocusEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  FocusInfo info;
+  info.tab_id = 1;
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingFocusEvent(info);
+  }
+}
+BENCHMARK(BM_GenerateAdReportingFocusEvent);
+
+void BM_GenerateAdReportingRestartEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingRestartEvent();
+  }
+}
+BENCHMARK(BM_GenerateAdReportingRestartEvent);
+
+void BM_GenerateAdReportingSettingsEvent(benchmark::State& state) {
+  AdsImplBenchmark benchmark;
+
+  for (auto _ : state) {
+    benchmark.ads()->GenerateAdReportingSettingsEvent();
+  }
+}
+BENCHMARK(BM_GenerateAdReportingSettingsEvent);
+
+}  // namespace
+
+}  // namespace ads
@@ -0,0 +1,444 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bat/ads/ads.h"
+
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/ads_impl.h"
+#include "bat/ads/internal/client_state.h"
+#include "bat/ads/internal/compression_helper.h"
+#include "bat/ads/internal/test_data_helper.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Contains;
+using ::testing::Invoke;
+using ::testing::InvokeWithoutArgs;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::WithArg;
+
+namespace ads {
+
+static const char kPageHtml[] =
+    "<html><body>Brave is the fastest, most secure browser</body></html>";
+
+class AdsInitializationTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<NiceMock<MockAdsClient>> mock_ads_client_;
+  std::unique_ptr<AdsImpl> ads_;
+
+  // Simulated clock, the callback for each asynchronous request is run once
+  // the clock reaches the time at which the request completes
+  int64_t now_in_milliseconds_;
+  std::multimap<int64_t, std::function<void()>> pending_callbacks_;
+
+  // Time at which ads could first be served, or -1 if they never could
+  int64_t ready_in_milliseconds_;
+
+  int64_t load_client_state_latency_in_milliseconds_;
+  int64_t load_user_model_latency_in_milliseconds_;
+  int64_t download_catalog_latency_in_milliseconds_;
+
+  std::string client_state_;
+  std::string user_model_;
+  std::string catalog_;
+  std::string saved_catalog_;
+  std::map<std::string, int> user_model_requests_;
+  std::vector<std::string> catalog_request_headers_;
+
+  AdsInitializationTest() :
+      mock_ads_client_(std::make_unique<NiceMock<MockAdsClient>>()),
+      ads_(std::make_unique<AdsImpl>(mock_ads_client_.get())),
+      now_in_milliseconds_(0),
+      ready_in_milliseconds_(-1),
+      load_client_state_latency_in_milliseconds_(100),
+      load_user_model_latency_in_milliseconds_(300),
+      download_catalog_latency_in_milliseconds_(1000) {
+    // You can do set-up work for each test here
+  }
+
+  ~AdsInitializationTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // If the constructor and destructor are not enough for setting up and
+  // cleaning up each test, you can use the following methods
+
+  void SetUp() override {
+    // Code here will be called immediately after the constructor (right before
+    // each test)
+
+    SetClientStateLocale("en");
+    user_model_ = helper::TestData::LoadResource("locales/en/user_model.json");
+    catalog_ = helper::TestData::Load("catalog.json");
+    helper::Compression::GzipCompress(catalog_, &saved_catalog_);
+
+    ON_CALL(*mock_ads_client_, IsAdsEnabled())
+        .WillByDefault(Return(true));
+
+    ON_CALL(*mock_ads_client_, GetAdsLocale())
+        .WillByDefault(Return("en_US"));
+
+    ON_CALL(*mock_ads_client_, GetLocales())
+        .WillByDefault(Return(std::vector<std::string>{"de", "en"}));
+
+    ON_CALL(*mock_ads_client_, LoadJsonSchema(_))
+        .WillByDefault(Invoke([](
+            const std::string& name) -> std::string {
+          return helper::TestData::LoadResource(name);
+        }));
+
+    ON_CALL(*mock_ads_client_, Load(_, _))
+        .WillByDefault(Invoke([this](
+            const std::string& name,
+            OnLoadCallback callback) {
+          auto value = client_state_;
+          if (name == _compressed_catalog_name) {
+            value = saved_catalog_;
+          }
+
+          CompleteAfter(load_client_state_latency_in_milliseconds_,
+              [callback, value]() {
+            if (value.empty()) {
+              callback(FAILED, value);
+              return;
+            }
+
+            callback(SUCCESS, value);
+          });
+        }));
+
+    ON_CALL(*mock_ads_client_, LoadUserModelForLocale(_, _))
+        .WillByDefault(Invoke([this](
+            const std::string& locale,
+            OnLoadCallback callback) {
+          user_model_requests_[locale]++;
+
+          auto user_model = user_model_;
+          CompleteAfter(load_user_model_latency_in_milliseconds_,
+              [callback, user_model]() {
+            callback(SUCCESS, user_model);
+          });
+        }));
+
+    ON_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+        .WillByDefault(
+            Invoke([this](
+                const std::string& url,
+                const std::vector<std::string>& headers,
+                const std::string& content,
+                const std::string& content_type,
+                const URLRequestMethod method,
+                URLRequestCallback callback) {
+              catalog_request_headers_ = headers;
+
+              // The catalog has not changed since it was saved, so respond to
+              // conditional requests with "304 Not Modified"
+              auto is_conditional = HasCatalogRequestHeader("If-None-Match");
+
+              auto catalog = catalog_;
+              CompleteAfter(download_catalog_latency_in_milliseconds_,
+                  [callback, catalog, is_conditional]() {
+                if (is_conditional) {
+                  callback(304, "", {});
+                  return;
+                }
+
+                callback(200, catalog, {});
+              });
+            }));
+
+    ON_CALL(*mock_ads_client_, Save(_, _, _))
+        .WillByDefault(
+            WithArg<2>(Invoke([](
+                OnSaveCallback callback) {
+              callback(SUCCESS);
+            })));
+
+    ON_CALL(*mock_ads_client_, CommitBundleState(_))
+        .WillByDefault(
+            WithArg<0>(Invoke([](
+                OnSaveCallback callback) {
+              callback(SUCCESS);
+            })));
+  }
+
+  void TearDown() override {
+    // Code here will be called immediately after each test (right before the
+    // destructor)
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  void SetClientStateLocale(const std::string& locale) {
+    ClientState state;
+    state.locale = locale;
+    client_state_ = state.ToJson();
+  }
+
+  // Saves the metadata of a bundle generated from the test catalog, i.e. the
+  // catalog is unchanged since the bundle was saved
+  void SetClientStateBundleMetadata() {
+    ClientState state;
+    state.locale = "en";
+    state.catalog_etag = "\"catalog\"";
+    state.catalog_id = "a3cd25e99647957ca54c18cb52e0784e1dd6584d";
+    state.catalog_version = 1;
+    state.catalog_ping = 7200000;
+    state.catalog_last_updated_timestamp_in_seconds = 1;
+    client_state_ = state.ToJson();
+  }
+
+  void CompleteAfter(
+      const int64_t latency_in_milliseconds,
+      std::function<void()> callback) {
+    pending_callbacks_.emplace(now_in_milliseconds_ + latency_in_milliseconds,
+        callback);
+  }
+
+  bool HasCatalogRequestHeader(const std::string& name) {
+    for (const auto& header : catalog_request_headers_) {
+      if (header.compare(0, name.size(), name) == 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void SetMobile() {
+    ClientInfo client_info;
+    client_info.platform = ANDROID_OS;
+
+    ON_CALL(*mock_ads_client_, GetClientInfo(_))
+        .WillByDefault(SetArgPointee<0>(client_info));
+  }
+
+  bool CanServeAds() {
+    return ads_->IsInitialized() && ads_->bundle_->IsReady();
+  }
+
+  void RunUntilIdle() {
+    RunUntil(std::numeric_limits<int64_t>::max());
+  }
+
+  void RunUntil(const int64_t time_in_milliseconds) {
+    while (!pending_callbacks_.empty() &&
+        pending_callbacks_.begin()->first <= time_in_milliseconds) {
+      auto pending_callback = pending_callbacks_.begin();
+      now_in_milliseconds_ = pending_callback->first;
+      auto callback = pending_callback->second;
+      pending_callbacks_.erase(pending_callback);
+
+      callback();
+
+      if (ready_in_milliseconds_ == -1 && CanServeAds()) {
+        ready_in_milliseconds_ = now_in_milliseconds_;
+      }
+    }
+  }
+};
+
+TEST_F(AdsInitializationTest, DoesNotLoadUserModelOnStartup) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, Load(_, _))
+      .Times(1);
+
+  EXPECT_CALL(*mock_ads_client_, LoadUserModelForLocale(_, _))
+      .Times(0);
+
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  // Act
+  ads_->Initialize();
+  RunUntilIdle();
+
+  // Assert
+  EXPECT_EQ(load_client_state_latency_in_milliseconds_ +
+      download_catalog_latency_in_milliseconds_, ready_in_milliseconds_);
+}
+
+TEST_F(AdsInitializationTest, CatalogIsProcessedOnceInitialized) {
+  // Arrange
+  download_catalog_latency_in_milliseconds_ = 50;
+
+  // Act
+  ads_->Initialize();
+  RunUntilIdle();
+
+  // Assert
+  EXPECT_EQ(load_client_state_latency_in_milliseconds_ +
+      download_catalog_latency_in_milliseconds_, ready_in_milliseconds_);
+}
+
+TEST_F(AdsInitializationTest, ClassifiesPagesVisitedWhileLoadingUserModel) {
+  // Arrange
+  ads_->Initialize();
+  RunUntilIdle();
+
+  // Act
+  ads_->ClassifyPage("https://brave.com", kPageHtml);
+  ads_->ClassifyPage("https://brave.com/about", kPageHtml);
+  auto pages_to_classify = ads_->pages_to_classify_.size();
+  RunUntilIdle();
+
+  // Assert
+  EXPECT_EQ(2UL, pages_to_classify);
+  EXPECT_TRUE(ads_->pages_to_classify_.empty());
+  EXPECT_EQ(1, user_model_requests_["en"]);
+}
+
+TEST_F(AdsInitializationTest, ServesAdRequestedWhileLoadingUserModel) {
+  // Arrange
+  SetMobile();
+
+  ads_->Initialize();
+  RunUntilIdle();
+
+  // Ads are requested from the Client on mobile, so each serve which gets as
+  // far as picking a category requests ads
+  int get_ads_requests = 0;
+  ON_CALL(*mock_ads_client_, GetAds(_, _, _))
+      .WillByDefault(InvokeWithoutArgs([&get_ads_requests]() {
+        get_ads_requests++;
+      }));
+
+  ads_->ClassifyPage("https://brave.com", kPageHtml);
+
+  // Act
+  ads_->CheckReadyAdServe(true);
+  auto get_ads_requests_while_loading = get_ads_requests;
+  auto is_ad_serve_pending = ads_->is_ad_serve_pending_;
+  RunUntilIdle();
+
+  // Assert
+  EXPECT_EQ(0, get_ads_requests_while_loading);
+  EXPECT_TRUE(is_ad_serve_pending);
+  EXPECT_EQ(1, get_ads_requests);
+  EXPECT_FALSE(ads_->is_ad_serve_pending_);
+  EXPECT_EQ(1, user_model_requests_["en"]);
+}
+
+TEST_F(AdsInitializationTest, KeepsUserModelForPreviousLocale) {
+  // Arrange
+  ads_->Initialize();
+  RunUntilIdle();
+
+  ads_->ClassifyPage("https://brave.com", kPageHtml);
+  RunUntilIdle();
+
+  ads_->ChangeLocale("de");
+  ads_->ClassifyPage("https://brave.com", kPageHtml);
+  RunUntilIdle();
+
+  // Act
+  ads_->ChangeLocale("en");
+  ads_->ClassifyPage("https://brave.com", kPageHtml);
+
+  // Assert
+  EXPECT_TRUE(ads_->pages_to_classify_.empty());
+  EXPECT_EQ(1, user_model_requests_["en"]);
+  EXPECT_EQ(1, user_model_requests_["de"]);
+}
+
+TEST_F(AdsInitializationTest, WarmStartsFromSavedBundleMetadata) {
+  // Arrange
+  SetClientStateBundleMetadata();
+
+  EXPECT_CALL(*mock_ads_client_, GetAds(_, "technology & computing", _))
+      .Times(1);
+
+  // Act
+  ads_->Initialize();
+  RunUntil(load_client_state_latency_in_milliseconds_);
+
+  ads_->ServeAdFromCategory("technology & computing");
+
+  // Assert
+  EXPECT_EQ(load_client_state_latency_in_milliseconds_,
+      ready_in_milliseconds_);
+  EXPECT_EQ(1UL, ads_->bundle_->GetCatalogVersion());
+  EXPECT_FALSE(ads_->bundle_->HasCategoriesInMemory());
+}
+
+TEST_F(AdsInitializationTest,
+    RebuildsRestoredBundleFromSavedCatalogIfNotModifiedOnDesktop) {
+  // Arrange
+  SetClientStateBundleMetadata();
+
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  EXPECT_CALL(*mock_ads_client_, Load(_, _))
+      .Times(AnyNumber());
+
+  EXPECT_CALL(*mock_ads_client_, Load(_compressed_catalog_name, _))
+      .Times(1);
+
+  EXPECT_CALL(*mock_ads_client_, Save(_, _, _))
+      .Times(AnyNumber());
+
+  EXPECT_CALL(*mock_ads_client_, Save(_compressed_catalog_name, _, _))
+      .Times(0);
+
+  // Act
+  ads_->Initialize();
+  RunUntilIdle();
+
+  // Assert
+  EXPECT_THAT(catalog_request_headers_,
+      Contains("If-None-Match: \"catalog\""));
+  EXPECT_TRUE(ads_->bundle_->HasCategoriesInMemory());
+  EXPECT_FALSE(ads_->bundle_->ShouldRebuildFromCatalog());
+  EXPECT_EQ(1UL, ads_->bundle_->GetCatalogVersion());
+}
+
+TEST_F(AdsInitializationTest,
+    DownloadsFullCatalogIfSavedCatalogIsMissingOnDesktop) {
+  // Arrange
+  SetClientStateBundleMetadata();
+  saved_catalog_ = "";
+
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(2);
+
+  // Act
+  ads_->Initialize();
+  RunUntilIdle();
+
+  // Assert
+  EXPECT_FALSE(HasCatalogRequestHeader("If-None-Match"));
+  EXPECT_TRUE(ads_->bundle_->HasCategoriesInMemory());
+  EXPECT_FALSE(ads_->bundle_->ShouldRebuildFromCatalog());
+}
+
+TEST_F(AdsInitializationTest, KeepsRestoredBundleIfCatalogNotModifiedOnMobile) {
+  // Arrange
+  SetMobile();
+  SetClientStateBundleMetadata();
+
+  // Act
+  ads_->Initialize();
+  RunUntilIdle();
+
+  // Assert
+  EXPECT_THAT(catalog_request_headers_,
+      Contains("If-None-Match: \"catalog\""));
+  EXPECT_EQ("a3cd25e99647957ca54c18cb52e0784e1dd6584d",
+      ads_->bundle_->GetCatalogId());
+  EXPECT_EQ(1UL, ads_->bundle_->GetCatalogVersion());
+}
+
+}  // namespace ads
@@ -8,7 +8,12 @@
 #include "bat/ads/internal/ads_serve.h"
 #include "bat/ads/internal/static_values.h"
 #include "bat/ads/internal/bundle.h"
+#include "bat/ads/internal/catalog_state.h"
+#include "bat/ads/internal/compression_helper.h"
+#include "bat/ads/internal/http_helper.h"
+#include "bat/ads/internal/json_helper.h"
 #include "bat/ads/internal/logging.h"
+#include "bat/ads/internal/trace_log.h"
 
 #include "base/rand_util.h"
 #include "base/time/time.h"
@@ -21,8 +26,14 @@ namespace ads {
 
 AdsServe::AdsServe(AdsImpl* ads, AdsClient* ads_client, Bundle* bundle) :
     url_(""),
+    catalog_etag_(""),
+    catalog_last_modified_(""),
+    catalog_state_(nullptr),
     next_catalog_check_timestamp_in_seconds(0),
-    next_retry_start_timer_in_(0),
+    should_request_full_catalog_(false),
+    is_catalog_processing_paused_(false),
+    paused_catalog_response_(nullptr),
+    retry_policy_(nullptr),
     catalog_last_updated_(0),
     ads_(ads),
     ads_client_(ads_client),
@@ -42,11 +53,50 @@ void AdsServe::BuildUrl() {
   url_ += CATALOG_PATH;
 }
 
+const std::vector<std::string> AdsServe::BuildCatalogRequestHeaders() const {
+  std::vector<std::string> headers = {
+    helper::Http::BuildHeader("Accept-Encoding", "gzip")
+  };
+
+  // Validators are only sent once a bundle has been generated, otherwise a
+  // "304 Not Modified" response would leave us without a bundle to serve from.
+  // A bundle restored from metadata on desktop is rebuilt from the saved
+  // catalog if it has not been modified, unless the saved catalog could not be
+  // used
+  if (!bundle_->IsReady() || (should_request_full_catalog_ &&
+      bundle_->ShouldRebuildFromCatalog())) {
+    return headers;
+  }
+
+  auto etag = ads_->client_->GetCatalogETag();
+  if (!etag.empty()) {
+    headers.push_back(helper::Http::BuildHeader("If-None-Match", etag));
+
+    // Ask for a delta against the catalog identified by the ETag, the Ads
+    // Serve responds with "226 IM Used" if it can generate one
+    if (CanRequestCatalogDelta()) {
+      headers.push_back(helper::Http::BuildHeader("A-IM", "catalog-delta"));
+    }
+  }
+
+  auto last_modified = ads_->client_->GetCatalogLastModified();
+  if (!last_modified.empty()) {
+    headers.push_back(helper::Http::BuildHeader("If-Modified-Since",
+        last_modified));
+  }
+
+  return headers;
+}
+
 void AdsServe::DownloadCatalog() {
   auto callback = std::bind(&AdsServe::OnCatalogDownloaded,
       this, url_, _1, _2, _3);
 
-  ads_client_->URLRequest(url_, {}, "", "", URLRequestMethod::GET, callback);
+  auto headers = BuildCatalogRequestHeaders();
+
+  ADS_TRACE_ASYNC_BEGIN("AdsServe::DownloadCatalog", this);
+  ads_client_->URLRequest(url_, headers, "", "", URLRequestMethod::GET,
+      callback);
 }
 
 void AdsServe::OnCatalogDownloaded(
@@ -54,6 +104,19 @@ void AdsServe::OnCatalogDownloaded(
     const int response_status_code,
     const std::string& response,
     const std::map<std::string, std::string>& headers) {
+  ADS_TRACE_ASYNC_END("AdsServe::DownloadCatalog", this);
+
+  if (is_catalog_processing_paused_) {
+    BLOG(INFO) << "Catalog downloaded while initializing, processing deferred";
+
+    paused_catalog_response_ = std::bind(&AdsServe::OnCatalogDownloaded,
+        this, url, response_status_code, response, headers);
+
+    return;
+  }
+
+  ADS_TRACE_EVENT("AdsServe::OnCatalogDownloaded");
+
   auto should_retry = false;
 
   if (response_status_code / 100 == 2) {
@@ -64,7 +127,46 @@ void AdsServe::OnCatalogDownloaded(
       BLOG(INFO) << "Successfully downloaded catalog";
     }
 
-    if (!ProcessCatalog(response)) {
+    catalog_etag_ = helper::Http::GetHeaderValue(headers, "ETag");
+    catalog_last_modified_ =
+        helper::Http::GetHeaderValue(headers, "Last-Modified");
+
+    // Decompress if the Client passed through the encoded response body,
+    // otherwise parse the response as is to avoid copying the catalog
+    const std::string* json = &response;
+    std::string uncompressed_response;
+    if (helper::Compression::IsGzipped(response)) {
+      if (helper::Compression::GzipUncompress(response,
+          &uncompressed_response)) {
+        BLOG(INFO) << "Decompressed catalog from " << response.size()
+            << " to " << uncompressed_response.size() << " bytes";
+
+        json = &uncompressed_response;
+      } else {
+        BLOG(ERROR) << "Failed to decompress catalog";
+
+        json = nullptr;
+      }
+    }
+
+    if (response_status_code == 226) {
+      // The base catalog state is consumed when the delta is applied, so
+      // check whether there was one before processing the delta
+      auto has_base_catalog_state = CanRequestCatalogDelta();
+      if (!json || !ProcessCatalogDelta(*json)) {
+        if (has_base_catalog_state) {
+          BLOG(WARNING) << "Failed to apply catalog delta, downloading full "
+              "catalog";
+
+          // Drop the base catalog state so that the full catalog is requested
+          catalog_state_.reset();
+          DownloadCatalog();
+          return;
+        }
+
+        should_retry = true;
+      }
+    } else if (!json || !ProcessCatalog(*json)) {
       should_retry = true;
     }
   } else if (response_status_code == 304) {
@@ -73,6 +175,11 @@ void AdsServe::OnCatalogDownloaded(
 
     BLOG(INFO) << "Catalog is already up to dates";
 
+    if (bundle_->ShouldRebuildFromCatalog()) {
+      LoadSavedCatalog();
+      return;
+    }
+
     UpdateNextCatalogCheck();
   } else {
     // TODO(Terry Mancey): Implement Log (#44)
@@ -89,7 +196,7 @@ void AdsServe::OnCatalogDownloaded(
     BLOG(ERROR) << "Failed to download catalog from:"
         << std::endl << "  url: " << url
         << std::endl << "  response_status_code: " << response_status_code
-        << std::endl << "  response: " << response
+        << std::endl << "  response: " << helper::JSON::GetSummary(response)
         << std::endl << "  headers: " << formatted_headers;
 
     should_retry = true;
@@ -105,18 +212,46 @@ uint64_t AdsServe::CatalogLastUpdated() const {
   return catalog_last_updated_;
 }
 
+void AdsServe::PauseCatalogProcessing() {
+  is_catalog_processing_paused_ = true;
+}
+
+void AdsServe::ResumeCatalogProcessing() {
+  is_catalog_processing_paused_ = false;
+
+  if (!paused_catalog_response_) {
+    return;
+  }
+
+  auto paused_catalog_response = std::move(paused_catalog_response_);
+  paused_catalog_response_ = nullptr;
+
+  paused_catalog_response();
+}
+
 void AdsServe::Reset() {
   ads_->StopCollectingActivity();
 
-  next_retry_start_timer_in_ = 0;
+  catalog_etag_ = "";
+  catalog_last_modified_ = "";
+  SaveCatalogValidators();
+
+  catalog_state_.reset();
+
+  is_catalog_processing_paused_ = false;
+  paused_catalog_response_ = nullptr;
+
+  GetRetryPolicy()->Reset();
 
   next_catalog_check_timestamp_in_seconds = 0;
 
+  should_request_full_catalog_ = false;
+
   ResetCatalog();
 }
 
 void AdsServe::UpdateNextCatalogCheck() {
-  next_retry_start_timer_in_ = 0;
+  GetRetryPolicy()->RecordSuccess();
 
   auto ping = bundle_->GetCatalogPing();
 
@@ -127,11 +262,105 @@ void AdsServe::UpdateNextCatalogCheck() {
   ads_->StartCollectingActivity(next_catalog_check_timestamp_in_seconds);
 }
 
+void AdsServe::SaveCatalogValidators() {
+  ads_->client_->SetCatalogValidators(catalog_etag_, catalog_last_modified_);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
+bool AdsServe::CanRequestCatalogDelta() const {
+  if (!catalog_state_ || !bundle_->IsReady()) {
+    return false;
+  }
+
+  return catalog_state_->catalog_id == bundle_->GetCatalogId();
+}
+
+void AdsServe::LoadSavedCatalog() {
+  BLOG(INFO) << "Loading saved catalog to rebuild bundle";
+
+  Catalog catalog(ads_client_);
+  auto callback = std::bind(&AdsServe::OnSavedCatalogLoaded, this, _1, _2);
+  ADS_TRACE_ASYNC_BEGIN("AdsServe::LoadSavedCatalog", this);
+  catalog.Load(callback);
+}
+
+void AdsServe::OnSavedCatalogLoaded(
+    const Result result,
+    const std::string& value) {
+  ADS_TRACE_ASYNC_END("AdsServe::LoadSavedCatalog", this);
+
+  std::string json;
+  if (result != SUCCESS ||
+      !helper::Compression::GzipUncompress(value, &json) ||
+      !RebuildBundleFromSavedCatalog(json)) {
+    BLOG(WARNING) << "Failed to rebuild bundle from saved catalog, "
+        "downloading full catalog";
+
+    should_request_full_catalog_ = true;
+    DownloadCatalog();
+    return;
+  }
+
+  UpdateNextCatalogCheck();
+}
+
+bool AdsServe::RebuildBundleFromSavedCatalog(const std::string& json) {
+  Catalog catalog(ads_client_);
+
+  BLOG(INFO) << "Parsing saved catalog";
+
+  if (!catalog.FromJson(json)) {
+    return false;
+  }
+
+  // The validators which were sent identify the catalog the bundle was
+  // generated from, so the saved catalog must be that catalog
+  if (catalog.GetId() != bundle_->GetCatalogId() ||
+      catalog.GetVersion() != bundle_->GetCatalogVersion()) {
+    BLOG(WARNING) << "Saved catalog id " << catalog.GetId()
+        << " does not match current catalog id " << bundle_->GetCatalogId();
+
+    return false;
+  }
+
+  // The saved catalog is unchanged, so it is not saved again
+  return GenerateBundleFromCatalog(&catalog);
+}
+
+bool AdsServe::IsCatalogCurrent(const std::string& json) const {
+  if (!bundle_->IsReady() || bundle_->ShouldRebuildFromCatalog()) {
+    return false;
+  }
+
+  std::string catalog_id;
+  uint64_t catalog_version;
+  if (!Catalog::GetIdAndVersion(json, &catalog_id, &catalog_version)) {
+    return false;
+  }
+
+  if (catalog_id.empty() || catalog_id != bundle_->GetCatalogId() ||
+      catalog_version != bundle_->GetCatalogVersion()) {
+    return false;
+  }
+
+  return true;
+}
+
 bool AdsServe::ProcessCatalog(const std::string& json) {
   // TODO(Terry Mancey): Refactor function to use callbacks
 
+  if (IsCatalogCurrent(json)) {
+    BLOG(INFO) << "Catalog id " << bundle_->GetCatalogId()
+        << " matches current catalog id, skipped parsing catalog";
+
+    SaveCatalogValidators();
+
+    UpdateNextCatalogCheck();
+
+    return true;
+  }
+
   Catalog catalog(ads_client_);
 
   BLOG(INFO) << "Parsing catalog";
@@ -147,33 +376,85 @@ bool AdsServe::ProcessCatalog(const std::string& json) {
   // { status: 'processed', campaigns: underscore.keys(campaigns).length,
   // creativeSets: underscore.keys(creativeSets).length
 
-  if (!catalog.HasChanged(bundle_->GetCatalogId())) {
+  if (!catalog.HasChanged(bundle_->GetCatalogId()) &&
+      !bundle_->ShouldRebuildFromCatalog()) {
     BLOG(WARNING) << "Catalog id " << catalog.GetId() <<
         " matches current catalog id " << bundle_->GetCatalogId();
 
+    catalog_state_ = catalog.GetCatalogState();
+
+    SaveCatalogValidators();
+
     UpdateNextCatalogCheck();
 
     return true;
   }
 
+  if (!GenerateBundleFromCatalog(&catalog)) {
+    return false;
+  }
+
+  SaveCatalog(&catalog, json);
+
+  return true;
+}
+
+bool AdsServe::ProcessCatalogDelta(const std::string& json) {
+  if (!CanRequestCatalogDelta()) {
+    BLOG(ERROR) << "Catalog delta received without a base catalog";
+
+    return false;
+  }
+
+  Catalog catalog(ads_client_);
+
+  BLOG(INFO) << "Applying catalog delta";
+
+  // Move the base catalog state into the merge rather than copying every
+  // campaign, the merged catalog state replaces it once the bundle has been
+  // generated
+  auto base_catalog_state = std::move(*catalog_state_);
+  catalog_state_.reset();
+
+  if (!catalog.FromDeltaJson(std::move(base_catalog_state), json)) {
+    return false;
+  }
+
+  BLOG(INFO) << "Catalog delta applied";
+
+  // The merged catalog is not persisted, as that would mean serializing and
+  // compressing the full catalog for every delta
+  return GenerateBundleFromCatalog(&catalog);
+}
+
+bool AdsServe::GenerateBundleFromCatalog(Catalog* catalog) {
+  ADS_TRACE_EVENT("AdsServe::GenerateBundleFromCatalog");
+
   BLOG(INFO) << "Generating bundle";
 
-  if (!bundle_->UpdateFromCatalog(catalog)) {
+  if (!bundle_->UpdateFromCatalog(*catalog)) {
     BLOG(ERROR) << "Failed to generate bundle";
 
     return false;
   }
 
-  auto callback = std::bind(&AdsServe::OnCatalogSaved, this, _1);
-  catalog.Save(json, callback);
+  catalog_state_ = catalog->GetCatalogState();
 
-  auto issuers_info = std::make_unique<IssuersInfo>(catalog.GetIssuers());
+  auto issuers_info = std::make_unique<IssuersInfo>(catalog->GetIssuers());
   ads_client_->SetCatalogIssuers(std::move(issuers_info));
 
   return true;
 }
 
+void AdsServe::SaveCatalog(Catalog* catalog, const std::string& json) {
+  auto callback = std::bind(&AdsServe::OnCatalogSaved, this, _1);
+  ADS_TRACE_ASYNC_BEGIN("AdsServe::SaveCatalog", this);
+  catalog->Save(json, callback);
+}
+
 void AdsServe::OnCatalogSaved(const Result result) {
+  ADS_TRACE_ASYNC_END("AdsServe::SaveCatalog", this);
+
   if (result != SUCCESS) {
     // If the catalog fails to save, we will retry the next time we collect
     // activity
@@ -184,22 +465,34 @@ void AdsServe::OnCatalogSaved(const Result result) {
   }
 
   BLOG(INFO) << "Successfully saved catalog";
-}
 
-void AdsServe::RetryDownloadingCatalog() {
-  BLOG(INFO) << "Retry downloading catalog";
+  RemoveLegacyCatalog();
+}
 
-  if (next_retry_start_timer_in_ == 0) {
+RetryPolicy* AdsServe::GetRetryPolicy() {
+  // Created on first use as the initial delay depends on the platform, which
+  // is not known when |AdsServe| is constructed
+  if (!retry_policy_) {
+    auto initial_delay_in_seconds = kRetryDownloadingCatalogAfterSeconds;
     if (ads_->IsMobile()) {
-      next_retry_start_timer_in_ = 2 * base::Time::kSecondsPerMinute;
-    } else {
-      next_retry_start_timer_in_ = base::Time::kSecondsPerMinute;
+      initial_delay_in_seconds = kRetryDownloadingCatalogOnMobileAfterSeconds;
     }
-  } else {
-    next_retry_start_timer_in_ *= 2;
+
+    retry_policy_ = std::make_unique<RetryPolicy>(ads_client_,
+        initial_delay_in_seconds, kMaximumRetryDownloadingCatalogAfterSeconds,
+        kMaximumCatalogDownloadFailures,
+        kCatalogCircuitBreakerCooldownInSeconds);
   }
 
-  ads_->StartCollectingActivity(next_retry_start_timer_in_);
+  return retry_policy_.get();
+}
+
+void AdsServe::RetryDownloadingCatalog() {
+  BLOG(INFO) << "Retry downloading catalog";
+
+  auto start_timer_in = GetRetryPolicy()->RecordFailure();
+
+  ads_->StartCollectingActivity(start_timer_in);
 }
 
 void AdsServe::ResetCatalog() {
@@ -208,6 +501,8 @@ void AdsServe::ResetCatalog() {
   Catalog catalog(ads_client_);
   auto callback = std::bind(&AdsServe::OnCatalogReset, this, _1);
   catalog.Reset(callback);
+
+  RemoveLegacyCatalog();
 }
 
 void AdsServe::OnCatalogReset(const Result result) {
@@ -220,4 +515,19 @@ void AdsServe::OnCatalogReset(const Result result) {
   BLOG(INFO) << "Successfully reset catalog";
 }
 
+void AdsServe::RemoveLegacyCatalog() {
+  Catalog catalog(ads_client_);
+  auto callback = std::bind(&AdsServe::OnLegacyCatalogRemoved, this, _1);
+  catalog.RemoveLegacyCatalog(callback);
+}
+
+void AdsServe::OnLegacyCatalogRemoved(const Result result) {
+  // Fails if the legacy catalog has already been removed, which is expected
+  if (result != SUCCESS) {
+    return;
+  }
+
+  BLOG(INFO) << "Successfully removed legacy catalog";
+}
+
 }  // namespace ads
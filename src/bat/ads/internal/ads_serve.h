@@ -7,18 +7,23 @@
 #define BAT_ADS_INTERNAL_ADS_SERVE_H_
 
 #include <stdint.h>
+#include <functional>
 #include <string>
+#include <vector>
 #include <map>
 #include <memory>
 
 #include "bat/ads/ads_client.h"
 
 #include "bat/ads/internal/ads_impl.h"
+#include "bat/ads/internal/retry_policy.h"
 
 namespace ads {
 
 class AdsImpl;
 class Bundle;
+class Catalog;
+struct CatalogState;
 
 class AdsServe {
  public:
@@ -31,31 +36,71 @@ class AdsServe {
 
   void DownloadCatalog();
   uint64_t CatalogLastUpdated() const;
+
+  // Holds the next catalog response until |ResumeCatalogProcessing| is called,
+  // so that the catalog can be downloaded while Ads are still initializing
+  void PauseCatalogProcessing();
+  void ResumeCatalogProcessing();
   void UpdateNextCatalogCheck();
 
+  void SaveCatalogValidators();
+
   void Reset();
 
  private:
   std::string url_;
   void BuildUrl();
 
+  const std::vector<std::string> BuildCatalogRequestHeaders() const;
+
+  // |ETag| and |Last-Modified| validators from the last successful catalog
+  // response, these are persisted once the bundle has been generated for the
+  // catalog so that the next catalog request can be made conditional
+  std::string catalog_etag_;
+  std::string catalog_last_modified_;
+
+  // The catalog state the bundle was last generated from, which is kept so
+  // that catalog deltas can be applied without downloading and parsing the
+  // full catalog
+  std::shared_ptr<CatalogState> catalog_state_;
+  bool CanRequestCatalogDelta() const;
+
   uint64_t next_catalog_check_timestamp_in_seconds;
 
+  // A bundle restored from metadata on desktop is rebuilt from the saved
+  // catalog if the catalog has not been modified. If the saved catalog cannot
+  // be used, the full catalog is requested instead
+  bool should_request_full_catalog_;
+  void LoadSavedCatalog();
+  void OnSavedCatalogLoaded(const Result result, const std::string& value);
+  bool RebuildBundleFromSavedCatalog(const std::string& json);
+
+  bool is_catalog_processing_paused_;
+  std::function<void()> paused_catalog_response_;
+
   void OnCatalogDownloaded(
       const std::string& url,
       const int response_status_code,
       const std::string& response,
       const std::map<std::string, std::string>& headers);
+  bool IsCatalogCurrent(const std::string& json) const;
   bool ProcessCatalog(const std::string& json);
+  bool ProcessCatalogDelta(const std::string& json);
+  bool GenerateBundleFromCatalog(Catalog* catalog);
+  void SaveCatalog(Catalog* catalog, const std::string& json);
   void OnCatalogSaved(const Result result);
 
-  uint64_t next_retry_start_timer_in_;
+  std::unique_ptr<RetryPolicy> retry_policy_;
+  RetryPolicy* GetRetryPolicy();
   void RetryDownloadingCatalog();
   uint64_t catalog_last_updated_;
 
   void ResetCatalog();
   void OnCatalogReset(const Result result);
 
+  void RemoveLegacyCatalog();
+  void OnLegacyCatalogRemoved(const Result result);
+
   AdsImpl* ads_;  // NOT OWNED
   AdsClient* ads_client_;  // NOT OWNED
   Bundle* bundle_;  // NOT OWNED
@@ -0,0 +1,650 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/ads_impl.h"
+#include "bat/ads/internal/ads_serve.h"
+#include "bat/ads/internal/catalog.h"
+#include "bat/ads/internal/compression_helper.h"
+#include "bat/ads/internal/static_values.h"
+
+#include "base/files/file_path.h"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Return;
+using ::testing::Invoke;
+using ::testing::WithArg;
+
+namespace ads {
+
+static const char kCatalogETag[] = "\"a3cd25e99647957ca54c18cb52e0784e\"";
+static const char kCatalogLastModified[] = "Wed, 06 Mar 2019 12:00:00 GMT";
+
+static const char kCatalogDeltaETag[] = "\"5b8ec5d2c1c5f1e2b6a7d7e1f2a3b4c5\"";
+
+static const char kRemovedCampaignId[] = "7ac6082f-eec5-4169-871d-09fd7e9c3093";
+static const char kAddedCreativeInstanceId[] =
+    "f9b2c6c6-3a9e-4c1b-9d4e-2f6a8b7c5d3e";
+
+static const char kCatalogDelta[] = R"({
+  "version": 1,
+  "ping": 7200000,
+  "baseCatalogId": "a3cd25e99647957ca54c18cb52e0784e1dd6584d",
+  "catalogId": "0b7b5e6c1c4d4c1e8f2a9d3b6e5f4a3c2b1d0e9f",
+  "removedCampaigns": [
+    "7ac6082f-eec5-4169-871d-09fd7e9c3093"
+  ],
+  "creatives": [
+    {
+      "creativeSetId": "6dfb42cc-e45e-40e2-ba6f-5741d594829d",
+      "creativeInstanceId": "f9b2c6c6-3a9e-4c1b-9d4e-2f6a8b7c5d3e",
+      "type": {
+        "code": "notification_all_v1",
+        "name": "notification",
+        "platform": "all",
+        "version": 1
+      },
+      "payload": {
+        "body": "Try our new single serve roasts",
+        "title": "1850coffee",
+        "targetUrl": "www.1850coffee.com"
+      }
+    }
+  ]
+})";
+
+class AdsServeTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<MockAdsClient> mock_ads_client_;
+  std::unique_ptr<AdsImpl> ads_;
+
+  // Local stand-in for the Ads Serve
+  std::string catalog_;
+  bool ignores_validators_;
+  bool compresses_response_;
+  std::string catalog_delta_;
+  uint64_t failing_requests_;
+  uint64_t catalog_requests_;
+  uint64_t bytes_downloaded_;
+  uint64_t bytes_saved_;
+  std::vector<std::string> last_request_headers_;
+
+  AdsServeTest() :
+      mock_ads_client_(std::make_unique<MockAdsClient>()),
+      ads_(std::make_unique<AdsImpl>(mock_ads_client_.get())),
+      catalog_(""),
+      ignores_validators_(false),
+      compresses_response_(false),
+      catalog_delta_(""),
+      failing_requests_(0),
+      catalog_requests_(0),
+      bytes_downloaded_(0),
+      bytes_saved_(0) {
+    // You can do set-up work for each test here
+  }
+
+  ~AdsServeTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // If the constructor and destructor are not enough for setting up and
+  // cleaning up each test, you can use the following methods
+
+  void SetUp() override {
+    // Code here will be called immediately after the constructor (right before
+    // each test)
+
+    auto path = GetTestDataPath().AppendASCII("catalog.json");
+    ASSERT_TRUE(Load(path, &catalog_));
+
+    EXPECT_CALL(*mock_ads_client_, IsAdsEnabled())
+        .WillRepeatedly(Return(true));
+
+    EXPECT_CALL(*mock_ads_client_, LoadJsonSchema(_))
+        .WillRepeatedly(
+            Invoke([this](
+                const std::string& name) -> std::string {
+              auto path = GetResourcesPath().AppendASCII(name);
+
+              std::string value;
+              Load(path, &value);
+
+              return value;
+            }));
+
+    ON_CALL(*mock_ads_client_, Save(_, _, _))
+        .WillByDefault(
+            WithArg<2>(Invoke([](
+                OnSaveCallback callback) {
+              callback(SUCCESS);
+            })));
+
+    ON_CALL(*mock_ads_client_, SaveBundleState(_, _))
+        .WillByDefault(
+            WithArg<1>(Invoke([](
+                OnSaveCallback callback) {
+              callback(SUCCESS);
+            })));
+
+    ON_CALL(*mock_ads_client_, CommitBundleState(_))
+        .WillByDefault(
+            WithArg<0>(Invoke([](
+                OnSaveCallback callback) {
+              callback(SUCCESS);
+            })));
+
+    ON_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+        .WillByDefault(
+            Invoke([this](
+                const std::string& url,
+                const std::vector<std::string>& headers,
+                const std::string& content,
+                const std::string& content_type,
+                const URLRequestMethod method,
+                URLRequestCallback callback) {
+              ServeCatalog(headers, callback);
+            }));
+  }
+
+  void TearDown() override {
+    // Code here will be called immediately after each test (right before the
+    // destructor)
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  void ServeCatalog(
+      const std::vector<std::string>& headers,
+      URLRequestCallback callback) {
+    catalog_requests_++;
+    last_request_headers_ = headers;
+
+    if (failing_requests_ > 0) {
+      failing_requests_--;
+      callback(503, "", {});
+      return;
+    }
+
+    auto if_none_match = std::string("If-None-Match: ") + kCatalogETag;
+    if (!catalog_delta_.empty() && HasHeader(headers, if_none_match) &&
+        HasHeader(headers, "A-IM: catalog-delta")) {
+      bytes_downloaded_ += catalog_delta_.size();
+
+      std::map<std::string, std::string> response_headers = {
+        {"etag", kCatalogDeltaETag},
+        {"im", "catalog-delta"}
+      };
+
+      callback(226, catalog_delta_, response_headers);
+      return;
+    }
+
+    if (!ignores_validators_ && HasHeader(headers, if_none_match)) {
+      bytes_saved_ += catalog_.size();
+      callback(304, "", {});
+      return;
+    }
+
+    std::map<std::string, std::string> response_headers = {
+      {"etag", kCatalogETag},
+      {"last-modified", kCatalogLastModified}
+    };
+
+    if (compresses_response_ && HasHeader(headers, "Accept-Encoding: gzip")) {
+      std::string compressed_catalog;
+      ASSERT_TRUE(helper::Compression::GzipCompress(catalog_,
+          &compressed_catalog));
+
+      bytes_downloaded_ += compressed_catalog.size();
+
+      response_headers.insert({"content-encoding", "gzip"});
+      callback(200, compressed_catalog, response_headers);
+      return;
+    }
+
+    bytes_downloaded_ += catalog_.size();
+
+    callback(200, catalog_, response_headers);
+  }
+
+  bool HasHeader(
+      const std::vector<std::string>& headers,
+      const std::string& header) {
+    return std::find(headers.begin(), headers.end(), header) != headers.end();
+  }
+
+  base::FilePath GetTestDataPath() {
+    return base::FilePath(FILE_PATH_LITERAL(
+        "brave/vendor/bat-native-ads/test/data"));
+  }
+
+  base::FilePath GetResourcesPath() {
+    return base::FilePath(FILE_PATH_LITERAL(
+        "brave/vendor/bat-native-ads/resources"));
+  }
+
+  bool Load(const base::FilePath path, std::string* value) {
+    if (!value) {
+      return false;
+    }
+
+    std::ifstream ifs{path.value()};
+    if (ifs.fail()) {
+      *value = "";
+      return false;
+    }
+
+    std::stringstream stream;
+    stream << ifs.rdbuf();
+    *value = stream.str();
+    return true;
+  }
+};
+
+TEST_F(AdsServeTest, DownloadCatalog_FirstRequestIsUnconditional) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_FALSE(HasHeader(last_request_headers_,
+      std::string("If-None-Match: ") + kCatalogETag));
+  EXPECT_FALSE(HasHeader(last_request_headers_,
+      std::string("If-Modified-Since: ") + kCatalogLastModified));
+  EXPECT_EQ(catalog_.size(), bytes_downloaded_);
+  EXPECT_TRUE(ads_->bundle_->IsReady());
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_PersistsValidators) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_EQ(kCatalogETag, ads_->client_->GetCatalogETag());
+  EXPECT_EQ(kCatalogLastModified, ads_->client_->GetCatalogLastModified());
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_PersistsBundleMetadata) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  auto metadata = ads_->client_->GetBundleMetadata();
+  EXPECT_EQ(ads_->bundle_->GetCatalogId(), metadata->catalog_id);
+  EXPECT_EQ(ads_->bundle_->GetCatalogVersion(), metadata->catalog_version);
+  EXPECT_TRUE(metadata->categories.empty());
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_SendsValidatorsOnNextPoll) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(2);
+
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_TRUE(HasHeader(last_request_headers_,
+      std::string("If-None-Match: ") + kCatalogETag));
+  EXPECT_TRUE(HasHeader(last_request_headers_,
+      std::string("If-Modified-Since: ") + kCatalogLastModified));
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_NotModifiedSavesBytes) {
+  // Arrange
+  const uint64_t polls = 12;
+
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(polls);
+
+  // Act
+  for (uint64_t i = 0; i < polls; i++) {
+    ads_->ads_serve_->DownloadCatalog();
+  }
+
+  // Assert
+  EXPECT_EQ(polls, catalog_requests_);
+  EXPECT_EQ(catalog_.size(), bytes_downloaded_);
+  EXPECT_EQ(catalog_.size() * (polls - 1), bytes_saved_);
+  EXPECT_TRUE(ads_->bundle_->IsReady());
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_AdvertisesGzip) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_TRUE(HasHeader(last_request_headers_, "Accept-Encoding: gzip"));
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_DecompressesGzippedResponse) {
+  // Arrange
+  compresses_response_ = true;
+
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_LT(bytes_downloaded_ * 3, catalog_.size());
+  EXPECT_TRUE(ads_->bundle_->IsReady());
+  EXPECT_EQ("a3cd25e99647957ca54c18cb52e0784e1dd6584d",
+      ads_->bundle_->GetCatalogId());
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_PersistsCompressedCatalog) {
+  // Arrange
+  std::string saved_catalog;
+
+  EXPECT_CALL(*mock_ads_client_, Save(_, _, _))
+      .Times(AnyNumber());
+
+  EXPECT_CALL(*mock_ads_client_, Save(_compressed_catalog_name, _, _))
+      .WillOnce(
+          Invoke([&saved_catalog](
+              const std::string& name,
+              const std::string& value,
+              OnSaveCallback callback) {
+            saved_catalog = value;
+            callback(SUCCESS);
+          }));
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_TRUE(helper::Compression::IsGzipped(saved_catalog));
+  EXPECT_LT(saved_catalog.size() * 3, catalog_.size());
+
+  std::string uncompressed_catalog;
+  EXPECT_TRUE(helper::Compression::GzipUncompress(saved_catalog,
+      &uncompressed_catalog));
+  EXPECT_EQ(catalog_, uncompressed_catalog);
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_RemovesLegacyCatalog) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, Save(_, _, _))
+      .Times(AnyNumber());
+
+  EXPECT_CALL(*mock_ads_client_, Save(_catalog_name, _, _))
+      .Times(0);
+
+  EXPECT_CALL(*mock_ads_client_, Reset(_catalog_name, _))
+      .Times(1);
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_RequestsDeltaOnNextPoll) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(2);
+
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_TRUE(HasHeader(last_request_headers_, "A-IM: catalog-delta"));
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_AppliesDelta) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, Save(_, _, _))
+      .Times(AnyNumber());
+
+  // Only the full catalog is persisted
+  EXPECT_CALL(*mock_ads_client_, Save(_compressed_catalog_name, _, _))
+      .Times(1);
+
+  ads_->ads_serve_->DownloadCatalog();
+
+  catalog_delta_ = kCatalogDelta;
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_EQ(catalog_.size() + catalog_delta_.size(), bytes_downloaded_);
+
+  EXPECT_EQ("0b7b5e6c1c4d4c1e8f2a9d3b6e5f4a3c2b1d0e9f",
+      ads_->bundle_->GetCatalogId());
+  EXPECT_EQ(kCatalogDeltaETag, ads_->client_->GetCatalogETag());
+
+  auto has_removed_campaign = false;
+  auto has_added_creative = false;
+  for (const auto& category : ads_->bundle_->GetState()->categories) {
+    for (const auto& ad : category.second) {
+      if (ad.campaign_id == kRemovedCampaignId) {
+        has_removed_campaign = true;
+      }
+
+      if (ad.uuid == kAddedCreativeInstanceId) {
+        has_added_creative = true;
+      }
+    }
+  }
+
+  EXPECT_FALSE(has_removed_campaign);
+  EXPECT_TRUE(has_added_creative);
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_DeltaBaseMismatchFallsBackToFullCatalog) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(3);
+
+  ads_->ads_serve_->DownloadCatalog();
+
+  catalog_delta_ = kCatalogDelta;
+  std::string base_catalog_id = "a3cd25e99647957ca54c18cb52e0784e1dd6584d";
+  catalog_delta_.replace(catalog_delta_.find(base_catalog_id),
+      base_catalog_id.length(), "unknown");
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_FALSE(HasHeader(last_request_headers_, "A-IM: catalog-delta"));
+  EXPECT_EQ("a3cd25e99647957ca54c18cb52e0784e1dd6584d",
+      ads_->bundle_->GetCatalogId());
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_PinnedBundleStateOutlivesUpdate) {
+  // Arrange
+  ads_->ads_serve_->DownloadCatalog();
+
+  auto bundle_state = ads_->bundle_->GetState();
+  auto categories = bundle_state->categories.size();
+
+  catalog_delta_ = kCatalogDelta;
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_EQ("a3cd25e99647957ca54c18cb52e0784e1dd6584d",
+      bundle_state->catalog_id);
+  EXPECT_EQ(categories, bundle_state->categories.size());
+  EXPECT_EQ("0b7b5e6c1c4d4c1e8f2a9d3b6e5f4a3c2b1d0e9f",
+      ads_->bundle_->GetState()->catalog_id);
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_FailedCommitKeepsBundleState) {
+  // Arrange
+  ads_->ads_serve_->DownloadCatalog();
+
+  auto bundle_state = ads_->bundle_->GetState();
+
+  EXPECT_CALL(*mock_ads_client_, CommitBundleState(_))
+      .WillOnce(
+          WithArg<0>(Invoke([](
+              OnSaveCallback callback) {
+            callback(FAILED);
+          })));
+
+  catalog_delta_ = kCatalogDelta;
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_EQ(bundle_state, ads_->bundle_->GetState());
+  EXPECT_EQ("a3cd25e99647957ca54c18cb52e0784e1dd6584d",
+      ads_->bundle_->GetCatalogId());
+  EXPECT_TRUE(ads_->bundle_->IsReady());
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_RetriesWithCappedJitteredBackoff) {
+  // Arrange
+  failing_requests_ = 12;
+
+  std::vector<uint64_t> timers;
+  ON_CALL(*mock_ads_client_, IsNetworkConnectionAvailable())
+      .WillByDefault(Return(true));
+  ON_CALL(*mock_ads_client_, SetTimer(_))
+      .WillByDefault(
+          Invoke([&timers](
+              const uint64_t time_offset) -> uint32_t {
+            timers.push_back(time_offset);
+            return static_cast<uint32_t>(timers.size());
+          }));
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+  while (!ads_->bundle_->IsReady() && timers.size() < 20) {
+    ads_->ads_serve_->DownloadCatalog();
+  }
+
+  // Assert
+  ASSERT_EQ(13ULL, timers.size());
+
+  for (uint64_t i = 0; i < 12; i++) {
+    EXPECT_GE(timers.at(i), 1ULL);
+    EXPECT_LE(timers.at(i), kCatalogCircuitBreakerCooldownInSeconds);
+  }
+
+  // The next catalog check after recovering is scheduled from the catalog
+  // ping rather than the backoff
+  EXPECT_GE(timers.back(), ads_->bundle_->GetCatalogPing());
+}
+
+TEST_F(AdsServeTest, GetIdAndVersion) {
+  // Arrange
+  std::string catalog_id;
+  uint64_t catalog_version;
+
+  // Act
+  auto result = Catalog::GetIdAndVersion(catalog_, &catalog_id,
+      &catalog_version);
+
+  // Assert
+  EXPECT_TRUE(result);
+  EXPECT_EQ("a3cd25e99647957ca54c18cb52e0784e1dd6584d", catalog_id);
+  EXPECT_EQ(1ULL, catalog_version);
+}
+
+TEST_F(AdsServeTest, GetIdAndVersion_IgnoresNestedMembers) {
+  // Arrange
+  std::string json = "{\"campaigns\":[{\"catalogId\":\"nested\","
+      "\"version\":2}],\"version\":1,\"catalogId\":\"top-level\"}";
+
+  std::string catalog_id;
+  uint64_t catalog_version;
+
+  // Act
+  auto result = Catalog::GetIdAndVersion(json, &catalog_id, &catalog_version);
+
+  // Assert
+  EXPECT_TRUE(result);
+  EXPECT_EQ("top-level", catalog_id);
+  EXPECT_EQ(1ULL, catalog_version);
+}
+
+TEST_F(AdsServeTest, GetIdAndVersion_MissingCatalogId) {
+  // Arrange
+  std::string json = "{\"version\":1,\"campaigns\":[]}";
+
+  std::string catalog_id;
+  uint64_t catalog_version;
+
+  // Act
+  auto result = Catalog::GetIdAndVersion(json, &catalog_id, &catalog_version);
+
+  // Assert
+  EXPECT_FALSE(result);
+}
+
+TEST_F(AdsServeTest, DownloadCatalog_UnchangedCatalogSkipsParsing) {
+  // Arrange
+  ignores_validators_ = true;
+
+  ads_->ads_serve_->DownloadCatalog();
+
+  EXPECT_CALL(*mock_ads_client_, LoadJsonSchema(_))
+      .Times(0);
+
+  EXPECT_CALL(*mock_ads_client_, BeginSaveBundleState(_))
+      .Times(0);
+
+  EXPECT_CALL(*mock_ads_client_, CommitBundleState(_))
+      .Times(0);
+
+  // Act
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Assert
+  EXPECT_EQ(catalog_.size() * 2, bytes_downloaded_);
+  EXPECT_TRUE(ads_->bundle_->IsReady());
+}
+
+TEST_F(AdsServeTest, Reset_ClearsValidators) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .Times(1);
+
+  ads_->ads_serve_->DownloadCatalog();
+
+  // Act
+  ads_->ads_serve_->Reset();
+
+  // Assert
+  EXPECT_TRUE(ads_->client_->GetCatalogETag().empty());
+  EXPECT_TRUE(ads_->client_->GetCatalogLastModified().empty());
+}
+
+}  // namespace ads
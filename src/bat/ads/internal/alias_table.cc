@@ -0,0 +1,109 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/alias_table.h"
+
+#include "base/rand_util.h"
+
+namespace ads {
+
+AliasTable::AliasTable() = default;
+
+AliasTable::AliasTable(const std::vector<double>& weights) :
+    probabilities_(weights.size(), 1.0),
+    aliases_(weights.size(), 0) {
+  auto size = weights.size();
+
+  double total = 0.0;
+  for (const auto weight : weights) {
+    total += weight;
+  }
+
+  if (size == 0 || total <= 0.0) {
+    // Uniform, as every probability is 1
+    return;
+  }
+
+  // Scale the weights so that the average weight is 1, then pair each column
+  // with a weight below 1 with a column with a weight above 1 to fill it
+  std::vector<double> scaled_weights;
+  scaled_weights.reserve(size);
+
+  std::vector<size_t> small;
+  std::vector<size_t> large;
+
+  for (size_t i = 0; i < size; i++) {
+    auto scaled_weight = weights.at(i) * size / total;
+    scaled_weights.push_back(scaled_weight);
+
+    if (scaled_weight < 1.0) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+
+  while (!small.empty() && !large.empty()) {
+    auto less = small.back();
+    small.pop_back();
+
+    auto more = large.back();
+    large.pop_back();
+
+    probabilities_.at(less) = scaled_weights.at(less);
+    aliases_.at(less) = more;
+
+    scaled_weights.at(more) =
+        (scaled_weights.at(more) + scaled_weights.at(less)) - 1.0;
+
+    if (scaled_weights.at(more) < 1.0) {
+      small.push_back(more);
+    } else {
+      large.push_back(more);
+    }
+  }
+
+  // Any remaining columns are full, allowing for floating point error
+  for (const auto index : large) {
+    probabilities_.at(index) = 1.0;
+  }
+
+  for (const auto index : small) {
+    probabilities_.at(index) = 1.0;
+  }
+}
+
+AliasTable::AliasTable(const AliasTable& table) = default;
+
+AliasTable::AliasTable(AliasTable&& table) noexcept = default;
+
+AliasTable& AliasTable::operator=(const AliasTable& table) = default;
+
+AliasTable& AliasTable::operator=(AliasTable&& table) noexcept = default;
+
+AliasTable::~AliasTable() = default;
+
+size_t AliasTable::GetSize() const {
+  return probabilities_.size();
+}
+
+bool AliasTable::IsEmpty() const {
+  return probabilities_.empty();
+}
+
+size_t AliasTable::Sample() const {
+  auto column = static_cast<size_t>(base::RandGenerator(GetSize()));
+  return Sample(column, base::RandDouble());
+}
+
+size_t AliasTable::Sample(const size_t column, const double coin) const {
+  if (coin < probabilities_.at(column)) {
+    return column;
+  }
+
+  return aliases_.at(column);
+}
+
+}  // namespace ads
@@ -0,0 +1,43 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_ALIAS_TABLE_H_
+#define BAT_ADS_INTERNAL_ALIAS_TABLE_H_
+
+#include <stddef.h>
+#include <vector>
+
+namespace ads {
+
+// Samples an index with probability proportional to its weight in constant
+// time using Vose's alias method. The table is built in linear time
+class AliasTable {
+ public:
+  AliasTable();
+  explicit AliasTable(const std::vector<double>& weights);
+  AliasTable(const AliasTable& table);
+  AliasTable(AliasTable&& table) noexcept;
+  AliasTable& operator=(const AliasTable& table);
+  AliasTable& operator=(AliasTable&& table) noexcept;
+  ~AliasTable();
+
+  size_t GetSize() const;
+  bool IsEmpty() const;
+
+  // Returns a random index, must not be called if the table is empty
+  size_t Sample() const;
+
+  // Returns the index for the specified |column| and |coin| in [0, 1), where
+  // both are uniformly distributed
+  size_t Sample(const size_t column, const double coin) const;
+
+ private:
+  std::vector<double> probabilities_;
+  std::vector<size_t> aliases_;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_ALIAS_TABLE_H_
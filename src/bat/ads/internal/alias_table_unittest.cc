@@ -0,0 +1,114 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stddef.h>
+#include <vector>
+
+#include "bat/ads/internal/alias_table.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class AliasTableTest : public ::testing::Test {
+ protected:
+  AliasTableTest() {
+    // You can do set-up work for each test here
+  }
+
+  ~AliasTableTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  std::vector<double> GetProbabilities(
+      const AliasTable& alias_table,
+      const size_t coins) {
+    auto size = alias_table.GetSize();
+    std::vector<double> probabilities(size, 0.0);
+
+    // Sweep every column with evenly spaced coins, which converges on the
+    // exact probabilities without depending on a random source
+    for (size_t column = 0; column < size; column++) {
+      for (size_t i = 0; i < coins; i++) {
+        auto coin = (i + 0.5) / coins;
+        auto index = alias_table.Sample(column, coin);
+        probabilities.at(index) += 1.0 / (size * coins);
+      }
+    }
+
+    return probabilities;
+  }
+};
+
+TEST_F(AliasTableTest, SamplesProportionallyToWeights) {
+  // Arrange
+  std::vector<double> weights = {1.0, 2.0, 3.0, 4.0, 10.0};
+  AliasTable alias_table(weights);
+
+  // Act
+  auto probabilities = GetProbabilities(alias_table, 10000);
+
+  // Assert
+  for (size_t i = 0; i < weights.size(); i++) {
+    EXPECT_NEAR(weights.at(i) / 20.0, probabilities.at(i), 0.001);
+  }
+}
+
+TEST_F(AliasTableTest, NeverSamplesZeroWeights) {
+  // Arrange
+  std::vector<double> weights = {0.0, 5.0, 0.0, 5.0};
+  AliasTable alias_table(weights);
+
+  // Act
+  auto probabilities = GetProbabilities(alias_table, 1000);
+
+  // Assert
+  EXPECT_EQ(0.0, probabilities.at(0));
+  EXPECT_EQ(0.0, probabilities.at(2));
+  EXPECT_NEAR(0.5, probabilities.at(1), 0.001);
+  EXPECT_NEAR(0.5, probabilities.at(3), 0.001);
+}
+
+TEST_F(AliasTableTest, SamplesUniformlyIfAllWeightsAreZero) {
+  // Arrange
+  std::vector<double> weights = {0.0, 0.0};
+  AliasTable alias_table(weights);
+
+  // Act
+  auto probabilities = GetProbabilities(alias_table, 1000);
+
+  // Assert
+  EXPECT_NEAR(0.5, probabilities.at(0), 0.001);
+  EXPECT_NEAR(0.5, probabilities.at(1), 0.001);
+}
+
+TEST_F(AliasTableTest, Sample) {
+  // Arrange
+  std::vector<double> weights = {1.0, 0.0, 1.0};
+  AliasTable alias_table(weights);
+
+  for (int i = 0; i < 1000; i++) {
+    // Act
+    auto index = alias_table.Sample();
+
+    // Assert
+    EXPECT_NE(1UL, index);
+    EXPECT_LT(index, weights.size());
+  }
+}
+
+TEST_F(AliasTableTest, Empty) {
+  // Arrange
+  AliasTable alias_table(std::vector<double>{});
+
+  // Act
+  auto is_empty = alias_table.IsEmpty();
+
+  // Assert
+  EXPECT_TRUE(is_empty);
+}
+
+}  // namespace ads
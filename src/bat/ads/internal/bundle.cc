@@ -3,20 +3,23 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <iterator>
 #include <vector>
 #include <map>
+#include <memory>
 #include <utility>
 
 #include "bat/ads/bundle_state.h"
 
 #include "bat/ads/internal/bundle.h"
+#include "bat/ads/internal/bundle_builder.h"
 #include "bat/ads/internal/catalog.h"
 #include "bat/ads/internal/json_helper.h"
 #include "bat/ads/internal/time_helper.h"
 #include "bat/ads/internal/logging.h"
 #include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/trace_log.h"
 
-#include "base/strings/string_util.h"
 #include "base/time/time.h"
 
 using std::placeholders::_1;
@@ -24,10 +27,9 @@ using std::placeholders::_1;
 namespace ads {
 
 Bundle::Bundle(AdsImpl* ads, AdsClient* ads_client) :
-    catalog_id_(""),
-    catalog_version_(0),
-    catalog_ping_(0),
-    catalog_last_updated_timestamp_in_seconds_(0),
+    serving_index_(std::make_shared<ServingIndex>(
+        std::make_shared<BundleState>())),
+    is_restored_from_metadata_(false),
     ads_(ads),
     ads_client_(ads_client) {
 }
@@ -35,18 +37,27 @@ Bundle::Bundle(AdsImpl* ads, AdsClient* ads_client) :
 Bundle::~Bundle() = default;
 
 bool Bundle::UpdateFromCatalog(const Catalog& catalog) {
-  // TODO(Terry Mancey): Refactor function to use callbacks
+  ADS_TRACE_EVENT("Bundle::UpdateFromCatalog");
 
-  auto bundle_state = GenerateFromCatalog(catalog);
-  if (!bundle_state) {
+  auto state = std::make_shared<BundleState>();
+  state->catalog_id = catalog.GetId();
+  state->catalog_version = catalog.GetVersion();
+  state->catalog_ping = catalog.GetPing();
+  state->catalog_last_updated_timestamp_in_seconds =
+      helper::Time::NowInSeconds();
+
+  ads_client_->BeginSaveBundleState(std::make_unique<BundleState>(*state));
+
+  if (!SaveCategories(catalog, &state->categories)) {
+    ads_client_->AbortBundleState();
     return false;
   }
 
-  auto callback = std::bind(&Bundle::OnStateSaved,
-      this, bundle_state->catalog_id, bundle_state->catalog_version,
-      bundle_state->catalog_ping,
-      bundle_state->catalog_last_updated_timestamp_in_seconds, _1);
-  ads_client_->SaveBundleState(std::move(bundle_state), callback);
+  auto serving_index = std::make_shared<ServingIndex>(std::move(state));
+
+  auto callback = std::bind(&Bundle::OnStateSaved, this, serving_index, _1);
+  ADS_TRACE_ASYNC_BEGIN("Bundle::SaveState", this);
+  ads_client_->CommitBundleState(callback);
 
   // TODO(Terry Mancey): Implement Log (#44)
   // 'Generated bundle'
@@ -57,29 +68,55 @@ bool Bundle::UpdateFromCatalog(const Catalog& catalog) {
 }
 
 void Bundle::Reset() {
-  auto bundle_state = std::make_unique<BundleState>();
+  auto state = std::make_shared<BundleState>();
 
-  auto callback = std::bind(&Bundle::OnStateReset,
-      this, bundle_state->catalog_id, bundle_state->catalog_version,
-      bundle_state->catalog_ping,
-      bundle_state->catalog_last_updated_timestamp_in_seconds, _1);
+  auto bundle_state = std::make_unique<BundleState>(*state);
+  auto serving_index = std::make_shared<ServingIndex>(std::move(state));
+
+  auto callback = std::bind(&Bundle::OnStateReset, this, serving_index, _1);
   ads_client_->SaveBundleState(std::move(bundle_state), callback);
 }
 
+void Bundle::RestoreFromMetadata(std::unique_ptr<BundleState> state) {
+  if (IsReady() || state->catalog_version == 0) {
+    return;
+  }
+
+  state->categories.clear();
+
+  std::shared_ptr<const BundleState> bundle_state = std::move(state);
+  std::atomic_store(&serving_index_,
+      std::make_shared<const ServingIndex>(std::move(bundle_state)));
+  campaigns_.clear();
+
+  is_restored_from_metadata_ = true;
+
+  BLOG(INFO) << "Restored bundle for catalog id " << GetCatalogId()
+      << " version " << GetCatalogVersion();
+}
+
+std::shared_ptr<const ServingIndex> Bundle::GetServingIndex() const {
+  return std::atomic_load(&serving_index_);
+}
+
+std::shared_ptr<const BundleState> Bundle::GetState() const {
+  return GetServingIndex()->GetBundleState();
+}
+
 const std::string Bundle::GetCatalogId() const {
-  return catalog_id_;
+  return GetState()->catalog_id;
 }
 
 uint64_t Bundle::GetCatalogVersion() const {
-  return catalog_version_;
+  return GetState()->catalog_version;
 }
 
 uint64_t Bundle::GetCatalogPing() const {
-  return catalog_ping_ / base::Time::kMillisecondsPerSecond;
+  return GetState()->catalog_ping / base::Time::kMillisecondsPerSecond;
 }
 
 uint64_t Bundle::GetCatalogLastUpdatedTimestampInSeconds() const {
-  return catalog_last_updated_timestamp_in_seconds_;
+  return GetState()->catalog_last_updated_timestamp_in_seconds;
 }
 
 bool Bundle::IsReady() const {
@@ -90,121 +127,101 @@ bool Bundle::IsReady() const {
   return true;
 }
 
+bool Bundle::HasCategoriesInMemory() const {
+  if (ads_->IsMobile() || is_restored_from_metadata_) {
+    return false;
+  }
+
+  return true;
+}
+
+bool Bundle::ShouldRebuildFromCatalog() const {
+  if (ads_->IsMobile() || !is_restored_from_metadata_) {
+    return false;
+  }
+
+  return true;
+}
+
+bool Bundle::IsAdInFlight(const AdInfo& ad, const uint64_t now_in_seconds) {
+  auto it = campaigns_.find(ad.campaign_id);
+  if (it == campaigns_.end()) {
+    it = campaigns_.insert({ad.campaign_id,
+        ServingIndex::GetCampaign(ad)}).first;
+  }
+
+  const auto& campaign = it->second;
+  if (now_in_seconds < campaign.start_timestamp_in_seconds ||
+      now_in_seconds >= campaign.end_timestamp_in_seconds) {
+    return false;
+  }
+
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
-// TODO(Terry Mancey): We should consider optimizing memory consumption when
-// generating the bundle by saving each campaign individually on the Client
-std::unique_ptr<BundleState> Bundle::GenerateFromCatalog(
-    const Catalog& catalog) {
-  // TODO(Terry Mancey): Refactor function to use callbacks
-
-  std::map<std::string, std::vector<AdInfo>> categories;
-
-  // Campaigns
-  for (const auto& campaign : catalog.GetCampaigns()) {
-    // Geo Targets
-    std::vector<std::string> regions = {};
-    for (const auto& geo_target : campaign.geo_targets) {
-      std::string code = geo_target.code;
-
-      if (std::find(regions.begin(), regions.end(), code)
-          != regions.end()) {
-        continue;
-      }
-
-      regions.push_back(code);
-    }
-
-    // Creative Sets
-    for (const auto& creative_set : campaign.creative_sets) {
-      // Segments
-      std::vector<std::string> hierarchy = {};
-      for (const auto& segment : creative_set.segments) {
-        auto name = base::ToLowerASCII(segment.name);
-
-        if (std::find(hierarchy.begin(), hierarchy.end(), name)
-            != hierarchy.end()) {
-          continue;
-        }
-
-        hierarchy.push_back(name);
-      }
-
-      if (hierarchy.empty()) {
-        BLOG(ERROR) << "creativeSet segments are empty";
-        return nullptr;
-      }
-
-      std::string category = base::JoinString(hierarchy, "-");
-
-      auto top_level = hierarchy.front();
-      uint64_t entries = 0;
-
-      for (const auto& creative : creative_set.creatives) {
-        AdInfo ad_info;
-        ad_info.creative_set_id = creative_set.creative_set_id;
-        ad_info.campaign_id = campaign.campaign_id;
-        ad_info.start_timestamp = campaign.start_at;
-        ad_info.end_timestamp = campaign.end_at;
-        ad_info.daily_cap = campaign.daily_cap;
-        ad_info.per_day = creative_set.per_day;
-        ad_info.total_max = creative_set.total_max;
-        ad_info.regions = regions;
-        ad_info.advertiser = creative.payload.title;
-        ad_info.notification_text = creative.payload.body;
-        ad_info.notification_url = creative.payload.target_url;
-        ad_info.uuid = creative.creative_instance_id;
-
-        if (categories.find(category) == categories.end()) {
-          categories.insert({category, {}});
-        }
-        categories.at(category).push_back(ad_info);
-        entries++;
-
-        if (categories.find(top_level) == categories.end()) {
-          categories.insert({top_level, {}});
-        }
-        categories.at(top_level).push_back(ad_info);
-        entries++;
-      }
-
-      if (entries == 0) {
-        BLOG(ERROR) << "creativeSet creatives are empty";
-        return nullptr;
-      }
-    }
+bool Bundle::SaveCategories(
+    const Catalog& catalog,
+    BundleCategories* categories) {
+  // Categories are handed off to the Client as soon as they are finalized. On
+  // mobile they are not kept, so that the full bundle is never resident in
+  // memory, otherwise they are also kept for serving ads
+  if (ads_->IsMobile()) {
+    categories = nullptr;
   }
 
-  auto state = std::make_unique<BundleState>();
-  state->catalog_id = catalog.GetId();
-  state->catalog_version = catalog.GetVersion();
-  state->catalog_ping = catalog.GetPing();
-  state->catalog_last_updated_timestamp_in_seconds =
-      helper::Time::NowInSeconds();
-  state->categories = categories;
+  auto callback = std::bind(&Bundle::OnCategoriesBuilt, this, categories, _1);
+
+  std::string error_description;
+  if (!BundleBuilder::BuildIncrementally(catalog.GetCampaigns(),
+      kBundleStateCategoriesBatchSize, callback, &error_description)) {
+    BLOG(ERROR) << error_description;
+    return false;
+  }
 
-  return state;
+  return true;
+}
+
+void Bundle::OnCategoriesBuilt(
+    BundleCategories* categories,
+    BundleCategories batch) {
+  auto bundle_state = std::make_unique<BundleState>();
+
+  if (!categories) {
+    bundle_state->categories = std::move(batch);
+  } else {
+    // Only the current batch is copied for the Client, and then moved into
+    // the categories kept in memory
+    bundle_state->categories = batch;
+    categories->insert(std::make_move_iterator(batch.begin()),
+        std::make_move_iterator(batch.end()));
+  }
+
+  ads_client_->SaveBundleStateCategories(std::move(bundle_state));
 }
 
 void Bundle::OnStateSaved(
-    const std::string& catalog_id,
-    const uint64_t& catalog_version,
-    const uint64_t& catalog_ping,
-    const uint64_t& catalog_last_updated_timestamp_in_seconds,
+    std::shared_ptr<const ServingIndex> serving_index,
     const Result result) {
+  ADS_TRACE_ASYNC_END("Bundle::SaveState", this);
+
   if (result != SUCCESS) {
     BLOG(ERROR) << "Failed to save bundle state";
 
     // If the bundle fails to save, we will retry the next time a bundle is
-    // downloaded from the Ads Serve
+    // downloaded from the Ads Serve. Ads continue to be served from the
+    // current bundle state
     return;
   }
 
-  catalog_id_ = catalog_id;
-  catalog_version_ = catalog_version;
-  catalog_ping_ = catalog_ping;
-  catalog_last_updated_timestamp_in_seconds_ =
-      catalog_last_updated_timestamp_in_seconds;
+  // Serves which are in flight keep the previous serving index and bundle state
+  // alive until they complete
+  std::atomic_store(&serving_index_, std::move(serving_index));
+  campaigns_.clear();
+  is_restored_from_metadata_ = false;
+
+  ads_->client_->SetBundleMetadata(*GetState());
 
   ads_->BundleUpdated();
 
@@ -212,10 +229,7 @@ void Bundle::OnStateSaved(
 }
 
 void Bundle::OnStateReset(
-    const std::string& catalog_id,
-    const uint64_t& catalog_version,
-    const uint64_t& catalog_ping,
-    const uint64_t& catalog_last_updated_timestamp_in_seconds,
+    std::shared_ptr<const ServingIndex> serving_index,
     const Result result) {
   if (result != SUCCESS) {
     BLOG(ERROR) << "Failed to reset bundle state";
@@ -223,11 +237,11 @@ void Bundle::OnStateReset(
     return;
   }
 
-  catalog_id_ = catalog_id;
-  catalog_version_ = catalog_version;
-  catalog_ping_ = catalog_ping;
-  catalog_last_updated_timestamp_in_seconds_ =
-      catalog_last_updated_timestamp_in_seconds;
+  std::atomic_store(&serving_index_, std::move(serving_index));
+  campaigns_.clear();
+  is_restored_from_metadata_ = false;
+
+  ads_->client_->SetBundleMetadata(*GetState());
 
   BLOG(INFO) << "Successfully reset bundle state";
 }
@@ -7,13 +7,16 @@
 #define BAT_ADS_INTERNAL_BUNDLE_H_
 
 #include <stdint.h>
+#include <map>
 #include <string>
 #include <memory>
 
 #include "bat/ads/ads_client.h"
 
 #include "bat/ads/internal/ads_impl.h"
+#include "bat/ads/internal/bundle_builder.h"
 #include "bat/ads/internal/catalog.h"
+#include "bat/ads/internal/serving_index.h"
 
 namespace ads {
 
@@ -27,6 +30,21 @@ class Bundle {
   bool UpdateFromCatalog(const Catalog& catalog);
   void Reset();
 
+  // Restores the catalog id, version, ping and last updated timestamp of the
+  // bundle state saved by the Client, see |Client::GetBundleMetadata|, so that
+  // ads can be served without downloading the catalog. Categories are not
+  // restored, so ads are requested from the Client until the bundle is next
+  // updated from a catalog
+  void RestoreFromMetadata(std::unique_ptr<BundleState> state);
+
+  // Returns the current serving index. A new bundle state and serving index
+  // are built alongside the current ones and only published once the Client
+  // has committed the bundle state, so callers should hold on to the returned
+  // serving index for the duration of a serve to see a consistent bundle
+  std::shared_ptr<const ServingIndex> GetServingIndex() const;
+
+  std::shared_ptr<const BundleState> GetState() const;
+
   const std::string GetCatalogId() const;
   uint64_t GetCatalogVersion() const;
   uint64_t GetCatalogPing() const;
@@ -34,28 +52,41 @@ class Bundle {
 
   bool IsReady() const;
 
+  // Returns false if ads should be requested from the Client using |GetAds|
+  // rather than served from the serving index, i.e. on mobile or if the bundle
+  // was restored from metadata
+  bool HasCategoriesInMemory() const;
+
+  // Returns true if the bundle was restored from metadata on desktop, in which
+  // case it must be rebuilt, from the saved catalog if the catalog has not
+  // changed, so that ads are served from the serving index again
+  bool ShouldRebuildFromCatalog() const;
+
+  // Returns true if the campaign of |ad| is in flight at |now_in_seconds|. Ads
+  // requested from the Client using |GetAds| only carry the timestamps of their
+  // flight window, which are parsed once per campaign until the bundle changes
+  bool IsAdInFlight(const AdInfo& ad, const uint64_t now_in_seconds);
+
  private:
-  std::unique_ptr<BundleState> GenerateFromCatalog(const Catalog& catalog);
+  bool SaveCategories(const Catalog& catalog, BundleCategories* categories);
+  void OnCategoriesBuilt(
+      BundleCategories* categories,
+      BundleCategories batch);
 
-  void SaveState();
   void OnStateSaved(
-      const std::string& catalog_id,
-      const uint64_t& catalog_version,
-      const uint64_t& catalog_ping,
-      const uint64_t& catalog_last_updated_timestamp_in_seconds,
+      std::shared_ptr<const ServingIndex> serving_index,
       const Result result);
 
   void OnStateReset(
-      const std::string& catalog_id,
-      const uint64_t& catalog_version,
-      const uint64_t& catalog_ping,
-      const uint64_t& catalog_last_updated_timestamp_in_seconds,
+      std::shared_ptr<const ServingIndex> serving_index,
       const Result result);
 
-  std::string catalog_id_;
-  uint64_t catalog_version_;
-  uint64_t catalog_ping_;
-  uint64_t catalog_last_updated_timestamp_in_seconds_;
+  std::shared_ptr<const ServingIndex> serving_index_;
+
+  bool is_restored_from_metadata_;
+
+  // Campaigns of ads requested from the Client, see |IsAdInFlight|
+  std::map<std::string, ServingIndex::Campaign> campaigns_;
 
   AdsImpl* ads_;  // NOT OWNED
   AdsClient* ads_client_;  // NOT OWNED
@@ -0,0 +1,284 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+#include <utility>
+
+#include "bat/ads/internal/bundle_builder.h"
+#include "bat/ads/internal/metrics.h"
+#include "bat/ads/internal/static_values.h"
+
+#include "base/strings/string_util.h"
+
+namespace ads {
+
+namespace {
+
+// Appends |value| to |values| if it has not already been appended. Small
+// vectors are scanned linearly, once |values| reaches
+// |kMaximumValuesForLinearDedup| values they are tracked in |seen| so that
+// deduping stays linear for campaigns with many geo targets or segments
+void AppendUnique(
+    const std::string& value,
+    std::vector<std::string>* values,
+    std::unordered_set<std::string>* seen) {
+  if (values->size() < kMaximumValuesForLinearDedup) {
+    if (std::find(values->begin(), values->end(), value) != values->end()) {
+      return;
+    }
+
+    values->push_back(value);
+
+    if (values->size() == kMaximumValuesForLinearDedup) {
+      seen->insert(values->begin(), values->end());
+    }
+
+    return;
+  }
+
+  if (!seen->insert(value).second) {
+    return;
+  }
+
+  values->push_back(value);
+}
+
+// Gets the deduped segment hierarchy for |creative_set|, returns false if the
+// creative set cannot be added to the bundle
+bool GetHierarchy(
+    const CreativeSetInfo& creative_set,
+    std::unordered_set<std::string>* seen,
+    std::vector<std::string>* hierarchy,
+    std::string* error_description) {
+  // Segments
+  seen->clear();
+  for (const auto& segment : creative_set.segments) {
+    AppendUnique(base::ToLowerASCII(segment.name), hierarchy, seen);
+  }
+
+  if (hierarchy->empty()) {
+    *error_description = "creativeSet segments are empty";
+    return false;
+  }
+
+  if (creative_set.creatives.empty()) {
+    *error_description = "creativeSet creatives are empty";
+    return false;
+  }
+
+  return true;
+}
+
+// Category named after the segment hierarchy of a creative set, and the top
+// level category of that hierarchy
+struct CreativeSetCategories {
+  std::string category;
+  std::string top_level_category;
+};
+
+using CampaignCategories = std::vector<CreativeSetCategories>;
+
+// Gets the categories of each creative set of |campaign|, returns false if
+// the campaign cannot be added to the bundle
+bool GetCampaignCategories(
+    const CampaignInfo& campaign,
+    CampaignCategories* campaign_categories,
+    std::string* error_description) {
+  std::unordered_set<std::string> seen;
+
+  campaign_categories->reserve(campaign.creative_sets.size());
+
+  for (const auto& creative_set : campaign.creative_sets) {
+    std::vector<std::string> hierarchy = {};
+    if (!GetHierarchy(creative_set, &seen, &hierarchy, error_description)) {
+      return false;
+    }
+
+    CreativeSetCategories creative_set_categories;
+    creative_set_categories.category = base::JoinString(hierarchy, "-");
+    creative_set_categories.top_level_category = std::move(hierarchy.front());
+    campaign_categories->push_back(std::move(creative_set_categories));
+  }
+
+  return true;
+}
+
+// Gets the categories of each campaign and the categories which are finalized
+// by each campaign, i.e. the categories that no later campaign adds ads to.
+// Returns false if any creative set cannot be added to the bundle, so that
+// nothing is emitted for a catalog which would fail part way through
+bool GetFinalizedCategories(
+    const std::vector<CampaignInfo>& campaigns,
+    std::vector<CampaignCategories>* campaign_categories,
+    std::vector<std::vector<std::string>>* finalized_categories,
+    std::string* error_description) {
+  std::map<std::string, size_t> last_campaign_indexes;
+
+  campaign_categories->assign(campaigns.size(), {});
+
+  for (size_t i = 0; i < campaigns.size(); i++) {
+    auto* categories = &campaign_categories->at(i);
+    if (!GetCampaignCategories(campaigns.at(i), categories,
+        error_description)) {
+      return false;
+    }
+
+    for (const auto& creative_set_categories : *categories) {
+      last_campaign_indexes[creative_set_categories.category] = i;
+      last_campaign_indexes[creative_set_categories.top_level_category] = i;
+    }
+  }
+
+  finalized_categories->assign(campaigns.size(), {});
+  for (const auto& last_campaign_index : last_campaign_indexes) {
+    finalized_categories->at(last_campaign_index.second).push_back(
+        last_campaign_index.first);
+  }
+
+  return true;
+}
+
+// Appends an ad for each creative of |campaign| to the categories of its
+// creative set, see |GetCampaignCategories|
+void AppendCampaignToCategories(
+    const CampaignInfo& campaign,
+    const CampaignCategories& campaign_categories,
+    BundleCategories* categories) {
+  std::unordered_set<std::string> seen;
+
+  // Geo Targets
+  std::vector<std::string> regions = {};
+  for (const auto& geo_target : campaign.geo_targets) {
+    AppendUnique(geo_target.code, &regions, &seen);
+  }
+
+  // Creative Sets
+  for (size_t i = 0; i < campaign.creative_sets.size(); i++) {
+    const auto& creative_set = campaign.creative_sets.at(i);
+    const auto& creative_set_categories = campaign_categories.at(i);
+
+    // References into |categories| remain valid on insertion, so both
+    // categories are only looked up once for all creatives of the creative
+    // set. Single segment creative sets have the same category and top level
+    // category, so ads are intentionally added to that category twice
+    auto& category_ads = (*categories)[creative_set_categories.category];
+    auto& top_level_ads =
+        (*categories)[creative_set_categories.top_level_category];
+
+    for (const auto& creative : creative_set.creatives) {
+      AdInfo ad_info;
+      ad_info.creative_set_id = creative_set.creative_set_id;
+      ad_info.campaign_id = campaign.campaign_id;
+      ad_info.start_timestamp = campaign.start_at;
+      ad_info.end_timestamp = campaign.end_at;
+      ad_info.daily_cap = campaign.daily_cap;
+      ad_info.per_day = creative_set.per_day;
+      ad_info.total_max = creative_set.total_max;
+      ad_info.regions = regions;
+      ad_info.advertiser = creative.payload.title;
+      ad_info.notification_text = creative.payload.body;
+      ad_info.notification_url = creative.payload.target_url;
+      ad_info.uuid = creative.creative_instance_id;
+
+      category_ads.push_back(ad_info);
+      top_level_ads.push_back(std::move(ad_info));
+    }
+  }
+}
+
+}  // namespace
+
+bool BundleBuilder::Build(
+    const std::vector<CampaignInfo>& campaigns,
+    BundleCategories* categories,
+    std::string* error_description) {
+  ADS_METRICS_SCOPED_TIMER(BUILD_BUNDLE_HISTOGRAM);
+
+  if (!categories) {
+    return false;
+  }
+
+  BundleCategories new_categories;
+  std::string new_error_description;
+  for (const auto& campaign : campaigns) {
+    CampaignCategories campaign_categories;
+    if (!GetCampaignCategories(campaign, &campaign_categories,
+        &new_error_description)) {
+      if (error_description != nullptr) {
+        *error_description = new_error_description;
+      }
+
+      return false;
+    }
+
+    AppendCampaignToCategories(campaign, campaign_categories, &new_categories);
+  }
+
+  *categories = std::move(new_categories);
+
+  return true;
+}
+
+bool BundleBuilder::BuildIncrementally(
+    const std::vector<CampaignInfo>& campaigns,
+    const size_t batch_size,
+    BundleCategoriesCallback callback,
+    std::string* error_description) {
+  ADS_METRICS_SCOPED_TIMER(BUILD_BUNDLE_HISTOGRAM);
+
+  std::string new_error_description;
+
+  std::vector<CampaignCategories> campaign_categories;
+  std::vector<std::vector<std::string>> finalized_categories;
+  if (!GetFinalizedCategories(campaigns, &campaign_categories,
+      &finalized_categories, &new_error_description)) {
+    if (error_description != nullptr) {
+      *error_description = new_error_description;
+    }
+
+    return false;
+  }
+
+  // Only categories which later campaigns still add ads to are held, finalized
+  // categories are moved into the next batch
+  BundleCategories categories;
+  BundleCategories batch;
+  size_t batch_ads = 0;
+
+  for (size_t i = 0; i < campaigns.size(); i++) {
+    AppendCampaignToCategories(campaigns.at(i), campaign_categories.at(i),
+        &categories);
+    CampaignCategories().swap(campaign_categories.at(i));
+
+    for (const auto& category : finalized_categories.at(i)) {
+      auto it = categories.find(category);
+      if (it == categories.end()) {
+        continue;
+      }
+
+      batch_ads += it->second.size();
+      batch.insert(std::move(*it));
+      categories.erase(it);
+    }
+
+    if (batch_ads >= batch_size) {
+      ADS_METRICS_EXCLUDE_FROM_SCOPED_TIMER();
+      callback(std::move(batch));
+      batch = BundleCategories();
+      batch_ads = 0;
+    }
+  }
+
+  if (!batch.empty()) {
+    ADS_METRICS_EXCLUDE_FROM_SCOPED_TIMER();
+    callback(std::move(batch));
+  }
+
+  return true;
+}
+
+}  // namespace ads
@@ -0,0 +1,47 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_BUNDLE_BUILDER_H_
+#define BAT_ADS_INTERNAL_BUNDLE_BUILDER_H_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+#include "bat/ads/ad_info.h"
+
+#include "bat/ads/internal/campaign_info.h"
+
+namespace ads {
+
+using BundleCategories = std::map<std::string, std::vector<AdInfo>>;
+
+using BundleCategoriesCallback = std::function<void(BundleCategories)>;
+
+// Transforms catalog campaigns into bundle categories
+class BundleBuilder {
+ public:
+  static bool Build(
+      const std::vector<CampaignInfo>& campaigns,
+      BundleCategories* categories,
+      std::string* error_description = nullptr);
+
+  // Builds serially and calls |callback| with batches of categories as soon as
+  // they are finalized, i.e. once no later campaign adds ads to them, so that
+  // the full set of categories is never resident at once. Batches hold at
+  // least |batch_size| ads except for the last batch, and each category is
+  // emitted exactly once. Nothing is emitted if the campaigns are invalid
+  static bool BuildIncrementally(
+      const std::vector<CampaignInfo>& campaigns,
+      const size_t batch_size,
+      BundleCategoriesCallback callback,
+      std::string* error_description = nullptr);
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_BUNDLE_BUILDER_H_
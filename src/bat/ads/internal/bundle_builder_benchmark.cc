@@ -0,0 +1,170 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bat/ads/bundle_state.h"
+
+#include "bat/ads/internal/bundle_builder.h"
+#include "bat/ads/internal/serving_index.h"
+#include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/synthetic_data_generator.h"
+#include "bat/ads/internal/test_data_helper.h"
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace ads {
+
+namespace {
+
+// Returns |count| synthetic campaigns, each with |geo_targets| geo targets of
+// which half are duplicates and a creative set with a segment hierarchy
+// |segments| deep, again half duplicates after lowercasing
+std::vector<CampaignInfo> GetSyntheticCampaigns(
+    const int64_t count,
+    const int64_t geo_targets,
+    const int64_t segments) {
+  std::vector<CampaignInfo> campaigns;
+  campaigns.reserve(count);
+
+  for (int64_t i = 0; i < count; i++) {
+    CampaignInfo campaign("campaign-" + std::to_string(i));
+
+    for (int64_t j = 0; j < geo_targets; j++) {
+      GeoTargetInfo geo_target;
+      geo_target.code = "R" + std::to_string(j % std::max<int64_t>(
+          geo_targets / 2, 1));
+      campaign.geo_targets.push_back(geo_target);
+    }
+
+    CreativeSetInfo creative_set("creative-set-" + std::to_string(i));
+    for (int64_t j = 0; j < segments; j++) {
+      SegmentInfo segment;
+      segment.name = (j % 2 == 0 ? "Segment" : "segment") +
+          std::to_string(j / 2);
+      creative_set.segments.push_back(segment);
+    }
+
+    for (int64_t j = 0; j < 4; j++) {
+      CreativeInfo creative;
+      creative.creative_instance_id =
+          "creative-" + std::to_string(i) + "-" + std::to_string(j);
+      creative_set.creatives.push_back(creative);
+    }
+
+    campaign.creative_sets.push_back(creative_set);
+    campaigns.push_back(campaign);
+  }
+
+  return campaigns;
+}
+
+void BM_BuildBundleWithManyGeoTargets(benchmark::State& state) {
+  auto campaigns = GetSyntheticCampaigns(1000, state.range(0), 2);
+
+  for (auto _ : state) {
+    BundleCategories categories;
+    BundleBuilder::Build(campaigns, &categories);
+    benchmark::DoNotOptimize(categories);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BuildBundleWithManyGeoTargets)
+    ->RangeMultiplier(4)->Range(4, 1024)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+void BM_BuildBundleWithDeepSegments(benchmark::State& state) {
+  auto campaigns = GetSyntheticCampaigns(1000, 1, state.range(0));
+
+  for (auto _ : state) {
+    BundleCategories categories;
+    BundleBuilder::Build(campaigns, &categories);
+    benchmark::DoNotOptimize(categories);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_BuildBundleWithDeepSegments)
+    ->RangeMultiplier(4)->Range(4, 1024)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+void BM_BuildBundle(benchmark::State& state) {
+  auto campaigns = helper::TestData::GetCampaigns(state.range(0));
+
+  for (auto _ : state) {
+    BundleCategories categories;
+    BundleBuilder::Build(campaigns, &categories);
+    benchmark::DoNotOptimize(categories);
+  }
+
+  state.SetItemsProcessed(state.iterations() * campaigns.size());
+}
+BENCHMARK(BM_BuildBundle)
+    ->Arg(1)->Arg(10)->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+// Generates the bundle for a catalog as |Bundle::UpdateFromCatalog| does on
+// desktop, i.e. builds the categories in batches, copying each batch as it is
+// handed off to the Client, and then indexes them for serving
+void BM_GenerateBundleFromCatalog(benchmark::State& state) {
+  auto campaigns = helper::TestData::GetCampaigns(state.range(0));
+
+  for (auto _ : state) {
+    auto bundle_state = std::make_shared<BundleState>();
+    auto* categories = &bundle_state->categories;
+    BundleBuilder::BuildIncrementally(campaigns,
+        kBundleStateCategoriesBatchSize, [categories](BundleCategories batch) {
+          BundleCategories client_batch = batch;
+          benchmark::DoNotOptimize(client_batch);
+          categories->insert(std::make_move_iterator(batch.begin()),
+              std::make_move_iterator(batch.end()));
+        });
+
+    auto serving_index = std::make_shared<ServingIndex>(bundle_state);
+    benchmark::DoNotOptimize(serving_index);
+  }
+
+  state.SetItemsProcessed(state.iterations() * campaigns.size());
+}
+BENCHMARK(BM_GenerateBundleFromCatalog)
+    ->Arg(1)->Arg(10)->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+// Builds bundles for generated catalogs of up to 100,000 campaigns, i.e.
+// ~70 times test/data/catalog.json, targeting several geos and segments
+void BM_BuildBundleFromSyntheticCatalog(benchmark::State& state) {
+  SyntheticCatalogOptions options;
+  options.campaigns = state.range(0);
+  options.creative_sets_per_campaign = 2;
+  options.creatives_per_creative_set = 2;
+  options.geo_targets = 10;
+  options.geo_targets_per_campaign = 3;
+
+  SyntheticDataGenerator generator(1);
+  auto catalog_state = generator.GenerateCatalogState(options);
+
+  for (auto _ : state) {
+    BundleCategories categories;
+    BundleBuilder::Build(catalog_state.campaigns, &categories);
+    benchmark::DoNotOptimize(categories);
+  }
+
+  state.SetItemsProcessed(state.iterations() * catalog_state.campaigns.size());
+}
+BENCHMARK(BM_BuildBundleFromSyntheticCatalog)
+    ->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+}  // namespace ads
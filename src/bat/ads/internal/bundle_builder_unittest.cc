@@ -0,0 +1,228 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <sstream>
+
+#include "bat/ads/bundle_state.h"
+
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/bundle_builder.h"
+#include "bat/ads/internal/catalog.h"
+
+#include "base/files/file_path.h"
+#include "base/strings/string_util.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+
+namespace ads {
+
+class BundleBuilderTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<MockAdsClient> mock_ads_client_;
+  std::unique_ptr<Catalog> catalog_;
+
+  BundleBuilderTest() :
+      mock_ads_client_(std::make_unique<MockAdsClient>()),
+      catalog_(std::make_unique<Catalog>(mock_ads_client_.get())) {
+    // You can do set-up work for each test here
+  }
+
+  ~BundleBuilderTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // If the constructor and destructor are not enough for setting up and
+  // cleaning up each test, you can use the following methods
+
+  void SetUp() override {
+    // Code here will be called immediately after the constructor (right before
+    // each test)
+
+    EXPECT_CALL(*mock_ads_client_, LoadJsonSchema(_))
+        .WillRepeatedly(
+            Invoke([this](
+                const std::string& name) -> std::string {
+              auto path = GetResourcesPath().AppendASCII(name);
+
+              std::string value;
+              Load(path, &value);
+
+              return value;
+            }));
+
+    auto path = GetTestDataPath().AppendASCII("catalog.json");
+
+    std::string json;
+    ASSERT_TRUE(Load(path, &json));
+    ASSERT_TRUE(catalog_->FromJson(json));
+  }
+
+  void TearDown() override {
+    // Code here will be called immediately after each test (right before the
+    // destructor)
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  std::string ToJson(const BundleCategories& categories) {
+    BundleState state;
+    state.categories = categories;
+    return state.ToJson();
+  }
+
+  base::FilePath GetTestDataPath() {
+    return base::FilePath(FILE_PATH_LITERAL(
+        "brave/vendor/bat-native-ads/test/data"));
+  }
+
+  base::FilePath GetResourcesPath() {
+    return base::FilePath(FILE_PATH_LITERAL(
+        "brave/vendor/bat-native-ads/resources"));
+  }
+
+  bool Load(const base::FilePath path, std::string* value) {
+    if (!value) {
+      return false;
+    }
+
+    std::ifstream ifs{path.value()};
+    if (ifs.fail()) {
+      *value = "";
+      return false;
+    }
+
+    std::stringstream stream;
+    stream << ifs.rdbuf();
+    *value = stream.str();
+    return true;
+  }
+};
+
+TEST_F(BundleBuilderTest, Build) {
+  // Arrange
+  BundleCategories categories;
+
+  // Act
+  auto result = BundleBuilder::Build(catalog_->GetCampaigns(),
+      &categories);
+
+  // Assert
+  EXPECT_TRUE(result);
+  EXPECT_FALSE(categories.empty());
+}
+
+TEST_F(BundleBuilderTest, Build_DedupesGeoTargetsAndSegments) {
+  // Arrange
+  CampaignInfo campaign("campaign");
+
+  for (int i = 0; i < 40; i++) {
+    GeoTargetInfo geo_target;
+    geo_target.code = "R" + std::to_string(i % 20);
+    campaign.geo_targets.push_back(geo_target);
+  }
+
+  CreativeSetInfo creative_set("creative_set");
+  for (int i = 0; i < 30; i++) {
+    SegmentInfo segment;
+    segment.name = (i % 2 == 0 ? "S" : "s") + std::to_string(i % 15);
+    creative_set.segments.push_back(segment);
+  }
+
+  CreativeInfo creative;
+  creative.creative_instance_id = "creative";
+  creative_set.creatives.push_back(creative);
+
+  campaign.creative_sets.push_back(creative_set);
+
+  std::vector<CampaignInfo> campaigns;
+  campaigns.push_back(campaign);
+
+  BundleCategories categories;
+
+  // Act
+  auto result = BundleBuilder::Build(campaigns, &categories);
+
+  // Assert
+  EXPECT_TRUE(result);
+
+  std::vector<std::string> expected_regions;
+  std::vector<std::string> hierarchy;
+  for (int i = 0; i < 20; i++) {
+    expected_regions.push_back("R" + std::to_string(i));
+  }
+  for (int i = 0; i < 15; i++) {
+    hierarchy.push_back("s" + std::to_string(i));
+  }
+
+  auto category = base::JoinString(hierarchy, "-");
+  ASSERT_EQ(1UL, categories.count(category));
+  ASSERT_EQ(1UL, categories.at(category).size());
+  EXPECT_EQ(expected_regions, categories.at(category).front().regions);
+  EXPECT_EQ(1UL, categories.at("s0").size());
+}
+
+TEST_F(BundleBuilderTest, BuildIncrementally_MatchesBuild) {
+  // Arrange
+  BundleCategories expected_categories;
+  ASSERT_TRUE(BundleBuilder::Build(catalog_->GetCampaigns(),
+      &expected_categories));
+
+  BundleCategories categories;
+  size_t batches = 0;
+  size_t duplicate_categories = 0;
+
+  auto callback = [&](BundleCategories batch) {
+    batches++;
+
+    for (auto& category : batch) {
+      if (!categories.insert(std::move(category)).second) {
+        duplicate_categories++;
+      }
+    }
+  };
+
+  // Act
+  auto result = BundleBuilder::BuildIncrementally(catalog_->GetCampaigns(),
+      1, callback);
+
+  // Assert
+  EXPECT_TRUE(result);
+  EXPECT_EQ(0UL, duplicate_categories);
+  EXPECT_GT(batches, 1UL);
+  EXPECT_EQ(ToJson(expected_categories), ToJson(categories));
+}
+
+TEST_F(BundleBuilderTest, BuildIncrementally_EmitsNothingOnFailure) {
+  // Arrange
+  std::vector<CampaignInfo> campaigns;
+  for (const auto& campaign : catalog_->GetCampaigns()) {
+    campaigns.push_back(campaign);
+  }
+
+  auto& creative_set = campaigns.back().creative_sets.front();
+  creative_set.creatives.clear();
+
+  size_t batches = 0;
+  auto callback = [&](BundleCategories batch) {
+    batches++;
+  };
+
+  std::string error_description;
+
+  // Act
+  auto result = BundleBuilder::BuildIncrementally(campaigns, 1, callback,
+      &error_description);
+
+  // Assert
+  EXPECT_FALSE(result);
+  EXPECT_EQ("creativeSet creatives are empty", error_description);
+  EXPECT_EQ(0UL, batches);
+}
+
+}  // namespace ads
@@ -0,0 +1,68 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <memory>
+
+#include "bat/ads/ads.h"
+#include "bat/ads/bundle_state.h"
+
+#include "bat/ads/internal/test_data_helper.h"
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace ads {
+
+namespace {
+
+void BM_BundleStateFromJson(benchmark::State& state) {
+  auto json = helper::TestData::GetBundleState(state.range(0))->ToJson();
+  auto json_schema = helper::TestData::LoadResource(_bundle_schema_name);
+
+  for (auto _ : state) {
+    BundleState bundle_state;
+    auto result = bundle_state.FromJson(json, json_schema);
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_BundleStateFromJson)
+    ->Arg(1)->Arg(10)->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_BundleStateFromTestData(benchmark::State& state) {
+  auto json = helper::TestData::Load("bundle.json");
+  auto json_schema = helper::TestData::LoadResource(_bundle_schema_name);
+
+  for (auto _ : state) {
+    BundleState bundle_state;
+    auto result = bundle_state.FromJson(json, json_schema);
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_BundleStateFromTestData);
+
+void BM_BundleStateToJson(benchmark::State& state) {
+  auto bundle_state = helper::TestData::GetBundleState(state.range(0));
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto json = bundle_state->ToJson();
+    bytes += json.size();
+    benchmark::DoNotOptimize(json);
+  }
+
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_BundleStateToJson)
+    ->Arg(1)->Arg(10)->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+}  // namespace ads
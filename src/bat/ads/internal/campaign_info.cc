@@ -40,6 +40,12 @@ CampaignInfo::CampaignInfo(const CampaignInfo& info) :
     geo_targets(info.geo_targets),
     creative_sets(info.creative_sets) {}
 
+CampaignInfo::CampaignInfo(CampaignInfo&& info) noexcept = default;
+
+CampaignInfo& CampaignInfo::operator=(const CampaignInfo& info) = default;
+
+CampaignInfo& CampaignInfo::operator=(CampaignInfo&& info) noexcept = default;
+
 CampaignInfo::~CampaignInfo() {}
 
 }  // namespace ads
@@ -18,6 +18,9 @@ struct CampaignInfo {
   CampaignInfo();
   explicit CampaignInfo(const std::string& campaign_id);
   explicit CampaignInfo(const CampaignInfo& info);
+  CampaignInfo(CampaignInfo&& info) noexcept;
+  CampaignInfo& operator=(const CampaignInfo& info);
+  CampaignInfo& operator=(CampaignInfo&& info) noexcept;
   ~CampaignInfo();
 
   std::string campaign_id;
@@ -3,16 +3,122 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <utility>
+
 #include "bat/ads/ads.h"
 
 #include "bat/ads/internal/catalog.h"
 #include "bat/ads/internal/catalog_state.h"
+#include "bat/ads/internal/compression_helper.h"
 #include "bat/ads/internal/json_helper.h"
 #include "bat/ads/internal/static_values.h"
 #include "bat/ads/internal/logging.h"
+#include "bat/ads/internal/trace_log.h"
+
+#include "rapidjson/reader.h"
 
 namespace ads {
 
+namespace {
+
+// Captures the top-level "catalogId" and "version" members and terminates
+// parsing as soon as both have been read. Nested values, i.e. campaigns and
+// issuers, are tokenized but never materialized
+class CatalogIdAndVersionHandler : public rapidjson::BaseReaderHandler<
+    rapidjson::UTF8<>, CatalogIdAndVersionHandler> {
+ public:
+  CatalogIdAndVersionHandler() :
+      depth_(0),
+      key_(""),
+      id_(""),
+      has_id_(false),
+      version_(0),
+      has_version_(false) {}
+
+  bool Default() {
+    key_.clear();
+    return true;
+  }
+
+  bool Uint(unsigned value) {
+    return Uint64(value);
+  }
+
+  bool Uint64(uint64_t value) {
+    if (depth_ == 1 && key_ == "version") {
+      version_ = value;
+      has_version_ = true;
+    }
+
+    key_.clear();
+    return !IsDone();
+  }
+
+  bool String(const char* value, rapidjson::SizeType length, bool copy) {
+    if (depth_ == 1 && key_ == "catalogId") {
+      id_.assign(value, length);
+      has_id_ = true;
+    }
+
+    key_.clear();
+    return !IsDone();
+  }
+
+  bool Key(const char* value, rapidjson::SizeType length, bool copy) {
+    if (depth_ == 1) {
+      key_.assign(value, length);
+    }
+
+    return true;
+  }
+
+  bool StartObject() {
+    depth_++;
+    key_.clear();
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType member_count) {
+    depth_--;
+    return true;
+  }
+
+  bool StartArray() {
+    depth_++;
+    key_.clear();
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType element_count) {
+    depth_--;
+    return true;
+  }
+
+  bool IsDone() const {
+    return has_id_ && has_version_;
+  }
+
+  const std::string& GetId() const {
+    return id_;
+  }
+
+  uint64_t GetVersion() const {
+    return version_;
+  }
+
+ private:
+  int depth_;
+  std::string key_;
+
+  std::string id_;
+  bool has_id_;
+
+  uint64_t version_;
+  bool has_version_;
+};
+
+}  // namespace
+
 Catalog::Catalog(AdsClient* ads_client) :
     ads_client_(ads_client),
     catalog_state_(nullptr) {}
@@ -20,6 +126,8 @@ Catalog::Catalog(AdsClient* ads_client) :
 Catalog::~Catalog() {}
 
 bool Catalog::FromJson(const std::string& json) {
+  ADS_TRACE_EVENT("Catalog::FromJson");
+
   auto catalog_state = std::make_unique<CatalogState>();
   auto json_schema = ads_client_->LoadJsonSchema(_catalog_schema_name);
   std::string error_description;
@@ -27,7 +135,7 @@ bool Catalog::FromJson(const std::string& json) {
       &error_description);
   if (result != SUCCESS) {
     BLOG(ERROR) << "Failed to to load catalog JSON (" << error_description
-        << "): " << json;
+        << "): " << helper::JSON::GetSummary(json);
 
     return false;
   }
@@ -39,6 +147,30 @@ bool Catalog::FromJson(const std::string& json) {
   return true;
 }
 
+bool Catalog::FromDeltaJson(
+    CatalogState base_catalog_state,
+    const std::string& json) {
+  ADS_TRACE_EVENT("Catalog::FromDeltaJson");
+
+  auto catalog_state = std::make_unique<CatalogState>();
+  auto json_schema = ads_client_->LoadJsonSchema(_catalog_delta_schema_name);
+  std::string error_description;
+  auto result = catalog_state->FromDeltaJson(std::move(base_catalog_state),
+      json, json_schema, &error_description);
+  if (result != SUCCESS) {
+    BLOG(ERROR) << "Failed to apply catalog delta (" << error_description
+        << "): " << helper::JSON::GetSummary(json);
+
+    return false;
+  }
+
+  catalog_state_.reset(catalog_state.release());
+
+  BLOG(INFO) << "Successfully applied catalog delta";
+
+  return true;
+}
+
 const std::string Catalog::GetId() const {
   return catalog_state_->catalog_id;
 }
@@ -59,14 +191,65 @@ const IssuersInfo& Catalog::GetIssuers() const {
   return catalog_state_->issuers;
 }
 
+std::shared_ptr<CatalogState> Catalog::GetCatalogState() const {
+  return catalog_state_;
+}
+
 void Catalog::Save(const std::string& json, OnSaveCallback callback) {
-  ads_client_->Save(_catalog_name, json, callback);
+  ADS_TRACE_EVENT("Catalog::Save");
+
+  // The catalog is persisted gzipped as |_compressed_catalog_name| to reduce
+  // the footprint on disk
+  std::string compressed_json;
+  if (!helper::Compression::GzipCompress(json, &compressed_json)) {
+    BLOG(ERROR) << "Failed to compress catalog";
+
+    callback(FAILED);
+    return;
+  }
+
+  ads_client_->Save(_compressed_catalog_name, compressed_json, callback);
+}
+
+void Catalog::Load(OnLoadCallback callback) {
+  ads_client_->Load(_compressed_catalog_name, callback);
 }
 
 void Catalog::Reset(OnSaveCallback callback) {
+  ads_client_->Reset(_compressed_catalog_name, callback);
+}
+
+void Catalog::RemoveLegacyCatalog(OnSaveCallback callback) {
   ads_client_->Reset(_catalog_name, callback);
 }
 
+// static
+bool Catalog::GetIdAndVersion(
+    const std::string& json,
+    std::string* id,
+    uint64_t* version) {
+  if (!id || !version) {
+    return false;
+  }
+
+  CatalogIdAndVersionHandler handler;
+  rapidjson::Reader reader;
+  rapidjson::StringStream stream(json.c_str());
+
+  // Parsing is terminated by the handler once both values have been read, so
+  // a termination error is expected on success
+  reader.Parse(stream, handler);
+
+  if (!handler.IsDone()) {
+    return false;
+  }
+
+  *id = handler.GetId();
+  *version = handler.GetVersion();
+
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool Catalog::HasChanged(const std::string& current_catalog_id) {
@@ -26,6 +26,20 @@ class Catalog {
 
   bool FromJson(const std::string& json);  // Deserialize
 
+  // Applies a catalog delta onto |base_catalog_state|, see
+  // |CatalogState::FromDeltaJson|
+  bool FromDeltaJson(
+      CatalogState base_catalog_state,
+      const std::string& json);
+
+  // Reads the top-level catalog id and version from the specified JSON using
+  // SAX events, without building a DOM or validating against the schema.
+  // Returns false if either could not be found
+  static bool GetIdAndVersion(
+      const std::string& json,
+      std::string* id,
+      uint64_t* version);
+
   const std::string GetId() const;
   uint64_t GetVersion() const;
   uint64_t GetPing() const;
@@ -36,9 +50,18 @@ class Catalog {
 
   const IssuersInfo& GetIssuers() const;
 
+  std::shared_ptr<CatalogState> GetCatalogState() const;
+
   void Save(const std::string& json, OnSaveCallback callback);
   void Reset(OnSaveCallback callback);
 
+  // Loads the catalog persisted by |Save|, |callback| is called with the
+  // gzipped catalog
+  void Load(OnLoadCallback callback);
+
+  // Removes the uncompressed catalog persisted by previous versions
+  void RemoveLegacyCatalog(OnSaveCallback callback);
+
  private:
   AdsClient* ads_client_;  // NOT OWNED
 
@@ -17,6 +17,12 @@ CreativeInfo::CreativeInfo(const CreativeInfo& info) :
     type(info.type),
     payload(info.payload) {}
 
+CreativeInfo::CreativeInfo(CreativeInfo&& info) noexcept = default;
+
+CreativeInfo& CreativeInfo::operator=(const CreativeInfo& info) = default;
+
+CreativeInfo& CreativeInfo::operator=(CreativeInfo&& info) noexcept = default;
+
 CreativeInfo::~CreativeInfo() {}
 
 }  // namespace ads
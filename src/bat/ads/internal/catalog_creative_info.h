@@ -16,6 +16,9 @@ namespace ads {
 struct CreativeInfo {
   CreativeInfo();
   explicit CreativeInfo(const CreativeInfo& info);
+  CreativeInfo(CreativeInfo&& info) noexcept;
+  CreativeInfo& operator=(const CreativeInfo& info);
+  CreativeInfo& operator=(CreativeInfo&& info) noexcept;
   ~CreativeInfo();
 
   std::string creative_instance_id;
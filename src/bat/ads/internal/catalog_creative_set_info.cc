@@ -31,6 +31,14 @@ CreativeSetInfo::CreativeSetInfo(const CreativeSetInfo& info) :
     segments(info.segments),
     creatives(info.creatives) {}
 
+CreativeSetInfo::CreativeSetInfo(CreativeSetInfo&& info) noexcept = default;
+
+CreativeSetInfo& CreativeSetInfo::operator=(
+    const CreativeSetInfo& info) = default;
+
+CreativeSetInfo& CreativeSetInfo::operator=(
+    CreativeSetInfo&& info) noexcept = default;
+
 CreativeSetInfo::~CreativeSetInfo() {}
 
 }  // namespace ads
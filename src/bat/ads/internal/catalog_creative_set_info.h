@@ -18,6 +18,9 @@ struct CreativeSetInfo {
   CreativeSetInfo();
   explicit CreativeSetInfo(const std::string& creative_set_id);
   CreativeSetInfo(const CreativeSetInfo& info);
+  CreativeSetInfo(CreativeSetInfo&& info) noexcept;
+  CreativeSetInfo& operator=(const CreativeSetInfo& info);
+  CreativeSetInfo& operator=(CreativeSetInfo&& info) noexcept;
   ~CreativeSetInfo();
 
   std::string creative_set_id;
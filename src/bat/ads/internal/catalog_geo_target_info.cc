@@ -15,6 +15,13 @@ GeoTargetInfo::GeoTargetInfo(const GeoTargetInfo& info) :
     code(info.code),
     name(info.name) {}
 
+GeoTargetInfo::GeoTargetInfo(GeoTargetInfo&& info) noexcept = default;
+
+GeoTargetInfo& GeoTargetInfo::operator=(const GeoTargetInfo& info) = default;
+
+GeoTargetInfo& GeoTargetInfo::operator=(
+    GeoTargetInfo&& info) noexcept = default;
+
 GeoTargetInfo::~GeoTargetInfo() {}
 
 }  // namespace ads
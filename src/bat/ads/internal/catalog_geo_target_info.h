@@ -13,6 +13,9 @@ namespace ads {
 struct GeoTargetInfo {
   GeoTargetInfo();
   explicit GeoTargetInfo(const GeoTargetInfo& info);
+  GeoTargetInfo(GeoTargetInfo&& info) noexcept;
+  GeoTargetInfo& operator=(const GeoTargetInfo& info);
+  GeoTargetInfo& operator=(GeoTargetInfo&& info) noexcept;
   ~GeoTargetInfo();
 
   std::string code;
@@ -17,6 +17,12 @@ PayloadInfo::PayloadInfo(const PayloadInfo& info) :
     title(info.title),
     target_url(info.target_url) {}
 
+PayloadInfo::PayloadInfo(PayloadInfo&& info) noexcept = default;
+
+PayloadInfo& PayloadInfo::operator=(const PayloadInfo& info) = default;
+
+PayloadInfo& PayloadInfo::operator=(PayloadInfo&& info) noexcept = default;
+
 PayloadInfo::~PayloadInfo() {}
 
 }  // namespace ads
@@ -13,6 +13,9 @@ namespace ads {
 struct PayloadInfo {
   PayloadInfo();
   explicit PayloadInfo(const PayloadInfo& info);
+  PayloadInfo(PayloadInfo&& info) noexcept;
+  PayloadInfo& operator=(const PayloadInfo& info);
+  PayloadInfo& operator=(PayloadInfo&& info) noexcept;
   ~PayloadInfo();
 
   std::string body;
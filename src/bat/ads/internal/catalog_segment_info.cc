@@ -15,6 +15,12 @@ SegmentInfo::SegmentInfo(const SegmentInfo& info) :
     code(info.code),
     name(info.name) {}
 
+SegmentInfo::SegmentInfo(SegmentInfo&& info) noexcept = default;
+
+SegmentInfo& SegmentInfo::operator=(const SegmentInfo& info) = default;
+
+SegmentInfo& SegmentInfo::operator=(SegmentInfo&& info) noexcept = default;
+
 SegmentInfo::~SegmentInfo() {}
 
 }  // namespace ads
@@ -13,6 +13,9 @@ namespace ads {
 struct SegmentInfo {
   SegmentInfo();
   explicit SegmentInfo(const SegmentInfo& info);
+  SegmentInfo(SegmentInfo&& info) noexcept;
+  SegmentInfo& operator=(const SegmentInfo& info);
+  SegmentInfo& operator=(SegmentInfo&& info) noexcept;
   ~SegmentInfo();
 
   std::string code;
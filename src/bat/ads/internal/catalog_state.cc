@@ -3,12 +3,199 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <set>
+#include <utility>
+
 #include "bat/ads/internal/catalog_state.h"
 #include "bat/ads/internal/json_helper.h"
+#include "bat/ads/internal/metrics.h"
 #include "bat/ads/internal/static_values.h"
 
 namespace ads {
 
+namespace {
+
+Result CreativeFromJson(
+    const rapidjson::Value& creative,
+    CreativeInfo* creative_info,
+    std::string* error_description) {
+  creative_info->creative_instance_id =
+      creative["creativeInstanceId"].GetString();
+
+  // Type
+  auto type = creative["type"].GetObject();
+
+  creative_info->type.code = type["code"].GetString();
+
+  std::string name = type["name"].GetString();
+  if (name != "notification") {
+    if (error_description != nullptr) {
+      *error_description = "Catalog invalid: Invalid creative type: "
+          + name + " for creativeInstanceId: " +
+          creative_info->creative_instance_id;
+    }
+
+    return FAILED;
+  }
+  creative_info->type.name = name;
+
+  creative_info->type.platform = type["platform"].GetString();
+
+  creative_info->type.version = type["version"].GetUint64();
+
+  // Payload
+  auto payload = creative["payload"].GetObject();
+
+  creative_info->payload.body = payload["body"].GetString();
+  creative_info->payload.title = payload["title"].GetString();
+  creative_info->payload.target_url = payload["targetUrl"].GetString();
+
+  return SUCCESS;
+}
+
+Result CreativeSetFromJson(
+    const rapidjson::Value& creative_set,
+    CreativeSetInfo* creative_set_info,
+    std::string* error_description) {
+  creative_set_info->creative_set_id =
+      creative_set["creativeSetId"].GetString();
+
+  std::string execution = creative_set["execution"].GetString();
+  if (execution != "per_click") {
+    if (error_description != nullptr) {
+      *error_description = "Catalog invalid: creativeSet has unknown "
+          "execution: " + execution;
+    }
+
+    return FAILED;
+  }
+  creative_set_info->execution = execution;
+
+  creative_set_info->per_day = creative_set["perDay"].GetUint();
+
+  creative_set_info->total_max = creative_set["totalMax"].GetUint();
+
+  // Segments
+  auto segments = creative_set["segments"].GetArray();
+  if (segments.Size() == 0) {
+    if (error_description != nullptr) {
+      *error_description = "Catalog invalid: No segments for creativeSet "
+          "with creativeSetId: " + creative_set_info->creative_set_id;
+    }
+
+    return FAILED;
+  }
+
+  creative_set_info->segments.reserve(segments.Size());
+  for (const auto& segment : segments) {
+    SegmentInfo segment_info;
+
+    segment_info.code = segment["code"].GetString();
+    segment_info.name = segment["name"].GetString();
+
+    creative_set_info->segments.push_back(std::move(segment_info));
+  }
+
+  // Creatives
+  auto creatives = creative_set["creatives"].GetArray();
+  creative_set_info->creatives.reserve(creatives.Size());
+  for (const auto& creative : creatives) {
+    CreativeInfo creative_info;
+
+    auto result = CreativeFromJson(creative, &creative_info,
+        error_description);
+    if (result != SUCCESS) {
+      return result;
+    }
+
+    creative_set_info->creatives.push_back(std::move(creative_info));
+  }
+
+  return SUCCESS;
+}
+
+Result CampaignFromJson(
+    const rapidjson::Value& campaign,
+    CampaignInfo* campaign_info,
+    std::string* error_description) {
+  campaign_info->campaign_id = campaign["campaignId"].GetString();
+  campaign_info->advertiser_id = campaign["advertiserId"].GetString();
+  campaign_info->name = campaign["name"].GetString();
+  campaign_info->start_at = campaign["startAt"].GetString();
+  campaign_info->end_at = campaign["endAt"].GetString();
+  campaign_info->daily_cap = campaign["dailyCap"].GetUint();
+  campaign_info->budget = campaign["budget"].GetUint();
+
+  // Geo targets
+  auto geo_targets = campaign["geoTargets"].GetArray();
+  campaign_info->geo_targets.reserve(geo_targets.Size());
+  for (const auto& geo_target : geo_targets) {
+    GeoTargetInfo geo_target_info;
+
+    geo_target_info.code = geo_target["code"].GetString();
+    geo_target_info.name = geo_target["name"].GetString();
+
+    campaign_info->geo_targets.push_back(std::move(geo_target_info));
+  }
+
+  // Creative sets
+  auto creative_sets = campaign["creativeSets"].GetArray();
+  campaign_info->creative_sets.reserve(creative_sets.Size());
+  for (const auto& creative_set : creative_sets) {
+    CreativeSetInfo creative_set_info;
+
+    auto result = CreativeSetFromJson(creative_set, &creative_set_info,
+        error_description);
+    if (result != SUCCESS) {
+      return result;
+    }
+
+    campaign_info->creative_sets.push_back(std::move(creative_set_info));
+  }
+
+  return SUCCESS;
+}
+
+void IssuersFromJson(
+    const rapidjson::Value& issuers,
+    IssuersInfo* issuers_info) {
+  for (const auto& issuer : issuers.GetArray()) {
+    IssuerInfo issuer_info;
+
+    std::string name = issuer["name"].GetString();
+    std::string public_key = issuer["publicKey"].GetString();
+
+    if (name == "confirmation") {
+      issuers_info->public_key = public_key;
+      continue;
+    }
+
+    issuer_info.name = name;
+    issuer_info.public_key = public_key;
+
+    issuers_info->issuers.push_back(std::move(issuer_info));
+  }
+}
+
+std::set<std::string> IdsFromJson(
+    const rapidjson::Value& document,
+    const char* name) {
+  std::set<std::string> ids;
+
+  if (!document.HasMember(name)) {
+    return ids;
+  }
+
+  for (const auto& id : document[name].GetArray()) {
+    ids.insert(id.GetString());
+  }
+
+  return ids;
+}
+
+}  // namespace
+
 CatalogState::CatalogState() :
     catalog_id(""),
     version(0),
@@ -23,19 +210,30 @@ CatalogState::CatalogState(const CatalogState& state) :
     campaigns(state.campaigns),
     issuers(state.issuers) {}
 
+CatalogState::CatalogState(CatalogState&& state) noexcept = default;
+
+CatalogState& CatalogState::operator=(const CatalogState& state) = default;
+
+CatalogState& CatalogState::operator=(CatalogState&& state) noexcept = default;
+
 CatalogState::~CatalogState() = default;
 
 Result CatalogState::FromJson(
     const std::string& json,
     const std::string& json_schema,
     std::string* error_description) {
-  rapidjson::Document catalog;
-  catalog.Parse(json.c_str());
+  ADS_METRICS_SCOPED_TIMER(PARSE_CATALOG_HISTOGRAM);
+  ADS_METRICS_INCREMENT(CATALOG_BYTES_PARSED_COUNTER, json.size());
+
+  rapidjson::MemoryPoolAllocator<> allocator(
+      helper::JSON::GetMemoryPoolChunkCapacity(json));
+  rapidjson::Document catalog(&allocator);
+  catalog.Parse(json.c_str(), json.size());
 
   auto result = helper::JSON::Validate(&catalog, json_schema);
   if (result != SUCCESS) {
     if (error_description != nullptr) {
-      *error_description = helper::JSON::GetLastError(&catalog);
+      *error_description = helper::JSON::GetLastError(&catalog, json);
     }
 
     return result;
@@ -59,136 +257,240 @@ Result CatalogState::FromJson(
   new_ping = catalog["ping"].GetUint64();
 
   // Campaigns
-  for (const auto& campaign : catalog["campaigns"].GetArray()) {
+  auto campaigns_array = catalog["campaigns"].GetArray();
+  new_campaigns.reserve(campaigns_array.Size());
+  for (const auto& campaign : campaigns_array) {
     CampaignInfo campaign_info;
 
-    campaign_info.campaign_id = campaign["campaignId"].GetString();
-    campaign_info.advertiser_id = campaign["advertiserId"].GetString();
-    campaign_info.name = campaign["name"].GetString();
-    campaign_info.start_at = campaign["startAt"].GetString();
-    campaign_info.end_at = campaign["endAt"].GetString();
-    campaign_info.daily_cap = campaign["dailyCap"].GetUint();
-    campaign_info.budget = campaign["budget"].GetUint();
+    result = CampaignFromJson(campaign, &campaign_info,
+        error_description);
+    if (result != SUCCESS) {
+      return result;
+    }
+
+    new_campaigns.push_back(std::move(campaign_info));
+  }
+
+  // Issuers
+  IssuersFromJson(catalog["issuers"], &new_issuers);
+
+  catalog_id = std::move(new_catalog_id);
+  version = new_version;
+  ping = new_ping;
+  campaigns = std::move(new_campaigns);
+  issuers = std::move(new_issuers);
+
+  return SUCCESS;
+}
 
-    // Geo targets
-    for (const auto& geo_target : campaign["geoTargets"].GetArray()) {
-      GeoTargetInfo geo_target_info;
+Result CatalogState::FromDeltaJson(
+    CatalogState base_state,
+    const std::string& json,
+    const std::string& json_schema,
+    std::string* error_description) {
+  ADS_METRICS_SCOPED_TIMER(PARSE_CATALOG_HISTOGRAM);
+  ADS_METRICS_INCREMENT(CATALOG_BYTES_PARSED_COUNTER, json.size());
 
-      geo_target_info.code = geo_target["code"].GetString();
-      geo_target_info.name = geo_target["name"].GetString();
+  rapidjson::MemoryPoolAllocator<> allocator(
+      helper::JSON::GetMemoryPoolChunkCapacity(json));
+  rapidjson::Document delta(&allocator);
+  delta.Parse(json.c_str(), json.size());
 
-      campaign_info.geo_targets.push_back(geo_target_info);
+  auto result = helper::JSON::Validate(&delta, json_schema);
+  if (result != SUCCESS) {
+    if (error_description != nullptr) {
+      *error_description = helper::JSON::GetLastError(&delta, json);
     }
 
-    // Creative sets
-    for (const auto& creative_set : campaign["creativeSets"].GetArray()) {
-      CreativeSetInfo creative_set_info;
+    return result;
+  }
 
-      creative_set_info.creative_set_id =
-          creative_set["creativeSetId"].GetString();
+  auto new_version = delta["version"].GetUint64();
+  if (new_version != 1) {
+    if (error_description != nullptr) {
+      *error_description = "Catalog delta invalid: unsupported version: " +
+          std::to_string(new_version);
+    }
 
-      std::string execution = creative_set["execution"].GetString();
-      if (execution != "per_click") {
-        if (error_description != nullptr) {
-          *error_description = "Catalog invalid: creativeSet has unknown "
-              "execution: " + execution;
-        }
+    return FAILED;
+  }
 
-        return FAILED;
+  std::string base_catalog_id = delta["baseCatalogId"].GetString();
+  if (base_catalog_id != base_state.catalog_id) {
+    if (error_description != nullptr) {
+      *error_description = "Catalog delta invalid: baseCatalogId " +
+          base_catalog_id + " does not match catalogId " +
+          base_state.catalog_id;
+    }
+
+    return FAILED;
+  }
+
+  std::vector<CampaignInfo> new_campaigns = std::move(base_state.campaigns);
+
+  // Campaigns, removed campaigns are applied first so that a campaign can be
+  // replaced in the same delta
+  auto removed_campaign_ids = IdsFromJson(delta, "removedCampaigns");
+  if (!removed_campaign_ids.empty()) {
+    new_campaigns.erase(std::remove_if(new_campaigns.begin(),
+        new_campaigns.end(), [&removed_campaign_ids](
+            const CampaignInfo& campaign) {
+          return removed_campaign_ids.find(campaign.campaign_id) !=
+              removed_campaign_ids.end();
+        }), new_campaigns.end());
+  }
+
+  std::map<std::string, size_t> campaign_indexes;
+  for (size_t i = 0; i < new_campaigns.size(); i++) {
+    campaign_indexes.insert({new_campaigns.at(i).campaign_id, i});
+  }
+
+  if (delta.HasMember("campaigns")) {
+    for (const auto& campaign : delta["campaigns"].GetArray()) {
+      CampaignInfo campaign_info;
+
+      result = CampaignFromJson(campaign, &campaign_info,
+          error_description);
+      if (result != SUCCESS) {
+        return result;
+      }
+
+      auto campaign_index = campaign_indexes.find(campaign_info.campaign_id);
+      if (campaign_index != campaign_indexes.end()) {
+        new_campaigns.at(campaign_index->second) = std::move(campaign_info);
+        continue;
       }
-      creative_set_info.execution = execution;
 
-      creative_set_info.per_day = creative_set["perDay"].GetUint();
+      campaign_indexes.insert({campaign_info.campaign_id,
+          new_campaigns.size()});
+      new_campaigns.push_back(std::move(campaign_info));
+    }
+  }
+
+  // Creative sets
+  auto removed_creative_set_ids = IdsFromJson(delta, "removedCreativeSets");
+  if (!removed_creative_set_ids.empty()) {
+    for (auto& campaign : new_campaigns) {
+      auto& creative_sets = campaign.creative_sets;
+      creative_sets.erase(std::remove_if(creative_sets.begin(),
+          creative_sets.end(), [&removed_creative_set_ids](
+              const CreativeSetInfo& creative_set) {
+            return removed_creative_set_ids.find(creative_set.creative_set_id)
+                != removed_creative_set_ids.end();
+          }), creative_sets.end());
+    }
+  }
 
-      creative_set_info.total_max = creative_set["totalMax"].GetUint();
+  if (delta.HasMember("creativeSets")) {
+    for (const auto& creative_set : delta["creativeSets"].GetArray()) {
+      std::string campaign_id = creative_set["campaignId"].GetString();
 
-      // Segments
-      auto segments = creative_set["segments"].GetArray();
-      if (segments.Size() == 0) {
+      auto campaign_index = campaign_indexes.find(campaign_id);
+      if (campaign_index == campaign_indexes.end()) {
         if (error_description != nullptr) {
-          *error_description = "Catalog invalid: No segments for creativeSet "
-              "with creativeSetId: " + creative_set_info.creative_set_id;
+          *error_description = "Catalog delta invalid: No campaign for "
+              "creativeSet with campaignId: " + campaign_id;
         }
 
         return FAILED;
       }
 
-      for (const auto& segment : segments) {
-        SegmentInfo segment_info;
-
-        segment_info.code = segment["code"].GetString();
-        segment_info.name = segment["name"].GetString();
+      CreativeSetInfo creative_set_info;
 
-        creative_set_info.segments.push_back(segment_info);
+      result = CreativeSetFromJson(creative_set, &creative_set_info,
+          error_description);
+      if (result != SUCCESS) {
+        return result;
       }
 
-      // Creatives
-      for (const auto& creative : creative_set["creatives"].GetArray()) {
-        CreativeInfo creative_info;
+      auto& creative_sets =
+          new_campaigns.at(campaign_index->second).creative_sets;
 
-        creative_info.creative_instance_id =
-            creative["creativeInstanceId"].GetString();
+      auto it = std::find_if(creative_sets.begin(), creative_sets.end(),
+          [&creative_set_info](const CreativeSetInfo& info) {
+            return info.creative_set_id == creative_set_info.creative_set_id;
+          });
 
-        // Type
-        auto type = creative["type"].GetObject();
+      if (it != creative_sets.end()) {
+        *it = std::move(creative_set_info);
+        continue;
+      }
 
-        creative_info.type.code = type["code"].GetString();
+      creative_sets.push_back(std::move(creative_set_info));
+    }
+  }
 
-        std::string name = type["name"].GetString();
-        if (name != "notification") {
-          if (error_description != nullptr) {
-            *error_description = "Catalog invalid: Invalid creative type: "
-                + name + " for creativeInstanceId: " +
-                creative_info.creative_instance_id;
-          }
+  // Creatives
+  auto removed_creative_instance_ids = IdsFromJson(delta, "removedCreatives");
+
+  std::map<std::string, CreativeSetInfo*> creative_sets_by_id;
+  for (auto& campaign : new_campaigns) {
+    for (auto& creative_set : campaign.creative_sets) {
+      if (!removed_creative_instance_ids.empty()) {
+        auto& creatives = creative_set.creatives;
+        creatives.erase(std::remove_if(creatives.begin(), creatives.end(),
+            [&removed_creative_instance_ids](const CreativeInfo& creative) {
+              return removed_creative_instance_ids.find(
+                  creative.creative_instance_id) !=
+                      removed_creative_instance_ids.end();
+            }), creatives.end());
+      }
 
-          return FAILED;
-        }
-        creative_info.type.name = name;
+      creative_sets_by_id.insert({creative_set.creative_set_id, &creative_set});
+    }
+  }
 
-        creative_info.type.platform = type["platform"].GetString();
+  if (delta.HasMember("creatives")) {
+    for (const auto& creative : delta["creatives"].GetArray()) {
+      std::string creative_set_id = creative["creativeSetId"].GetString();
 
-        creative_info.type.version = type["version"].GetUint64();
+      auto creative_set = creative_sets_by_id.find(creative_set_id);
+      if (creative_set == creative_sets_by_id.end()) {
+        if (error_description != nullptr) {
+          *error_description = "Catalog delta invalid: No creativeSet for "
+              "creative with creativeSetId: " + creative_set_id;
+        }
 
-        // Payload
-        auto payload = creative["payload"].GetObject();
+        return FAILED;
+      }
 
-        creative_info.payload.body = payload["body"].GetString();
-        creative_info.payload.title = payload["title"].GetString();
-        creative_info.payload.target_url = payload["targetUrl"].GetString();
+      CreativeInfo creative_info;
 
-        creative_set_info.creatives.push_back(creative_info);
+      result = CreativeFromJson(creative, &creative_info,
+          error_description);
+      if (result != SUCCESS) {
+        return result;
       }
 
-      campaign_info.creative_sets.push_back(creative_set_info);
-    }
-
-    new_campaigns.push_back(campaign_info);
-  }
+      auto& creatives = creative_set->second->creatives;
 
-  // Issuers
-  for (const auto& issuer : catalog["issuers"].GetArray()) {
-    IssuerInfo issuer_info;
+      auto it = std::find_if(creatives.begin(), creatives.end(),
+          [&creative_info](const CreativeInfo& info) {
+            return info.creative_instance_id ==
+                creative_info.creative_instance_id;
+          });
 
-    std::string name = issuer["name"].GetString();
-    std::string public_key = issuer["publicKey"].GetString();
+      if (it != creatives.end()) {
+        *it = std::move(creative_info);
+        continue;
+      }
 
-    if (name == "confirmation") {
-      new_issuers.public_key = public_key;
-      continue;
+      creatives.push_back(std::move(creative_info));
     }
+  }
 
-    issuer_info.name = name;
-    issuer_info.public_key = public_key;
-
-    new_issuers.issuers.push_back(issuer_info);
+  // Issuers are replaced as a whole if they have changed
+  IssuersInfo new_issuers = std::move(base_state.issuers);
+  if (delta.HasMember("issuers")) {
+    new_issuers = IssuersInfo();
+    IssuersFromJson(delta["issuers"], &new_issuers);
   }
 
-  catalog_id = new_catalog_id;
+  catalog_id = delta["catalogId"].GetString();
   version = new_version;
-  ping = new_ping;
-  campaigns = new_campaigns;
-  issuers = new_issuers;
+  ping = delta["ping"].GetUint64();
+  campaigns = std::move(new_campaigns);
+  issuers = std::move(new_issuers);
 
   return SUCCESS;
 }
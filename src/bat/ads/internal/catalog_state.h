@@ -21,6 +21,9 @@ namespace ads {
 struct CatalogState {
   CatalogState();
   explicit CatalogState(const CatalogState& state);
+  CatalogState(CatalogState&& state) noexcept;
+  CatalogState& operator=(const CatalogState& state);
+  CatalogState& operator=(CatalogState&& state) noexcept;
   ~CatalogState();
 
   Result FromJson(
@@ -28,6 +31,17 @@ struct CatalogState {
       const std::string& json_schema,
       std::string* error_description = nullptr);
 
+  // Applies a catalog delta onto |base_state|. Campaigns, creative sets and
+  // creatives are removed by id and then added or replaced, so that only what
+  // has changed since the base catalog needs to be downloaded and parsed.
+  // Fails if the delta was not generated against the base catalog id. The base
+  // state is consumed by the merge, so callers should move it in
+  Result FromDeltaJson(
+      CatalogState base_state,
+      const std::string& json,
+      const std::string& json_schema,
+      std::string* error_description = nullptr);
+
   std::string catalog_id;
   uint64_t version;
   uint64_t ping;
@@ -0,0 +1,76 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "bat/ads/ads.h"
+
+#include "bat/ads/internal/catalog_state.h"
+#include "bat/ads/internal/synthetic_data_generator.h"
+#include "bat/ads/internal/test_data_helper.h"
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace ads {
+
+namespace {
+
+void BM_CatalogStateFromJson(benchmark::State& state) {
+  auto json = helper::TestData::GetCatalogJson(state.range(0));
+  auto json_schema = helper::TestData::LoadResource(_catalog_schema_name);
+
+  for (auto _ : state) {
+    CatalogState catalog_state;
+    auto result = catalog_state.FromJson(json, json_schema);
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_CatalogStateFromJson)
+    ->Arg(1)->Arg(10)->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_CatalogStateFromTestData(benchmark::State& state) {
+  auto json = helper::TestData::Load("catalog.json");
+  auto json_schema = helper::TestData::LoadResource(_catalog_schema_name);
+
+  for (auto _ : state) {
+    CatalogState catalog_state;
+    auto result = catalog_state.FromJson(json, json_schema);
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_CatalogStateFromTestData);
+
+void BM_CatalogStateFromSyntheticJson(benchmark::State& state) {
+  SyntheticCatalogOptions options;
+  options.campaigns = state.range(0);
+  options.creative_sets_per_campaign = 2;
+  options.creatives_per_creative_set = 2;
+  options.geo_targets = 10;
+  options.geo_targets_per_campaign = 3;
+
+  SyntheticDataGenerator generator(1);
+  auto json = generator.GenerateCatalogJson(options);
+  auto json_schema = helper::TestData::LoadResource(_catalog_schema_name);
+
+  for (auto _ : state) {
+    CatalogState catalog_state;
+    auto result = catalog_state.FromJson(json, json_schema);
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_CatalogStateFromSyntheticJson)
+    ->RangeMultiplier(10)->Range(1000, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+}  // namespace ads
@@ -0,0 +1,178 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/catalog_state_writer.h"
+
+namespace ads {
+
+void SaveToJson(JsonWriter* writer, const CatalogState& state) {
+  writer->StartObject();
+
+  writer->String("version");
+  writer->Uint64(state.version);
+
+  writer->String("ping");
+  writer->Uint64(state.ping);
+
+  writer->String("catalogId");
+  writer->String(state.catalog_id.c_str());
+
+  writer->String("campaigns");
+  writer->StartArray();
+  for (const auto& campaign : state.campaigns) {
+    writer->StartObject();
+
+    writer->String("campaignId");
+    writer->String(campaign.campaign_id.c_str());
+
+    writer->String("advertiserId");
+    writer->String(campaign.advertiser_id.c_str());
+
+    writer->String("name");
+    writer->String(campaign.name.c_str());
+
+    writer->String("startAt");
+    writer->String(campaign.start_at.c_str());
+
+    writer->String("endAt");
+    writer->String(campaign.end_at.c_str());
+
+    writer->String("dailyCap");
+    writer->Uint(campaign.daily_cap);
+
+    writer->String("budget");
+    writer->Uint(campaign.budget);
+
+    writer->String("geoTargets");
+    writer->StartArray();
+    for (const auto& geo_target : campaign.geo_targets) {
+      writer->StartObject();
+
+      writer->String("code");
+      writer->String(geo_target.code.c_str());
+
+      writer->String("name");
+      writer->String(geo_target.name.c_str());
+
+      writer->EndObject();
+    }
+    writer->EndArray();
+
+    writer->String("creativeSets");
+    writer->StartArray();
+    for (const auto& creative_set : campaign.creative_sets) {
+      writer->StartObject();
+
+      writer->String("creativeSetId");
+      writer->String(creative_set.creative_set_id.c_str());
+
+      writer->String("execution");
+      writer->String(creative_set.execution.c_str());
+
+      writer->String("perDay");
+      writer->Uint(creative_set.per_day);
+
+      writer->String("totalMax");
+      writer->Uint(creative_set.total_max);
+
+      writer->String("segments");
+      writer->StartArray();
+      for (const auto& segment : creative_set.segments) {
+        writer->StartObject();
+
+        writer->String("code");
+        writer->String(segment.code.c_str());
+
+        writer->String("name");
+        writer->String(segment.name.c_str());
+
+        writer->EndObject();
+      }
+      writer->EndArray();
+
+      writer->String("creatives");
+      writer->StartArray();
+      for (const auto& creative : creative_set.creatives) {
+        writer->StartObject();
+
+        writer->String("creativeInstanceId");
+        writer->String(creative.creative_instance_id.c_str());
+
+        writer->String("type");
+        writer->StartObject();
+
+        writer->String("code");
+        writer->String(creative.type.code.c_str());
+
+        writer->String("name");
+        writer->String(creative.type.name.c_str());
+
+        writer->String("platform");
+        writer->String(creative.type.platform.c_str());
+
+        writer->String("version");
+        writer->Uint64(creative.type.version);
+
+        writer->EndObject();
+
+        writer->String("payload");
+        writer->StartObject();
+
+        writer->String("body");
+        writer->String(creative.payload.body.c_str());
+
+        writer->String("title");
+        writer->String(creative.payload.title.c_str());
+
+        writer->String("targetUrl");
+        writer->String(creative.payload.target_url.c_str());
+
+        writer->EndObject();
+
+        writer->EndObject();
+      }
+      writer->EndArray();
+
+      writer->EndObject();
+    }
+    writer->EndArray();
+
+    writer->EndObject();
+  }
+  writer->EndArray();
+
+  writer->String("issuers");
+  writer->StartArray();
+
+  if (!state.issuers.public_key.empty()) {
+    writer->StartObject();
+
+    writer->String("name");
+    writer->String("confirmation");
+
+    writer->String("publicKey");
+    writer->String(state.issuers.public_key.c_str());
+
+    writer->EndObject();
+  }
+
+  for (const auto& issuer : state.issuers.issuers) {
+    writer->StartObject();
+
+    writer->String("name");
+    writer->String(issuer.name.c_str());
+
+    writer->String("publicKey");
+    writer->String(issuer.public_key.c_str());
+
+    writer->EndObject();
+  }
+
+  writer->EndArray();
+
+  writer->EndObject();
+}
+
+}  // namespace ads
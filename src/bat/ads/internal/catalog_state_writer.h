@@ -0,0 +1,21 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_CATALOG_STATE_WRITER_H_
+#define BAT_ADS_INTERNAL_CATALOG_STATE_WRITER_H_
+
+#include "bat/ads/internal/catalog_state.h"
+#include "bat/ads/internal/json_helper.h"
+
+namespace ads {
+
+// Writes |state| in the catalog format, so that tests and benchmarks can
+// generate catalogs. The library only ever reads catalogs, so this is part of
+// the test support
+void SaveToJson(JsonWriter* writer, const CatalogState& state);
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_CATALOG_STATE_WRITER_H_
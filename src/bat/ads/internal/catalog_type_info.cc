@@ -19,6 +19,12 @@ TypeInfo::TypeInfo(const TypeInfo& info) :
     platform(info.platform),
     version(info.version) {}
 
+TypeInfo::TypeInfo(TypeInfo&& info) noexcept = default;
+
+TypeInfo& TypeInfo::operator=(const TypeInfo& info) = default;
+
+TypeInfo& TypeInfo::operator=(TypeInfo&& info) noexcept = default;
+
 TypeInfo::~TypeInfo() {}
 
 }  // namespace ads
@@ -14,6 +14,9 @@ namespace ads {
 struct TypeInfo {
   TypeInfo();
   explicit TypeInfo(const TypeInfo& info);
+  TypeInfo(TypeInfo&& info) noexcept;
+  TypeInfo& operator=(const TypeInfo& info);
+  TypeInfo& operator=(TypeInfo&& info) noexcept;
   ~TypeInfo();
 
   std::string code;
@@ -3,10 +3,16 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <utility>
+
+#include "bat/ads/bundle_state.h"
+
 #include "bat/ads/internal/client.h"
 #include "bat/ads/internal/json_helper.h"
+#include "bat/ads/internal/metrics.h"
 #include "bat/ads/internal/time_helper.h"
 #include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/trace_log.h"
 #include "bat/ads/internal/logging.h"
 
 using std::placeholders::_1;
@@ -29,13 +35,19 @@ void Client::SaveState() {
     return;
   }
 
+  ADS_METRICS_SCOPED_TIMER(SAVE_CLIENT_STATE_HISTOGRAM);
+  ADS_TRACE_EVENT("Client::SaveState");
+
   auto json = client_state_->ToJson();
+  ADS_METRICS_INCREMENT(CLIENT_STATE_BYTES_SAVED_COUNTER, json.size());
   auto callback = std::bind(&Client::OnStateSaved, this, _1);
+  ADS_TRACE_ASYNC_BEGIN("Client::SaveState", this);
   ads_client_->Save(_client_name, json, callback);
 }
 
 void Client::LoadState() {
   auto callback = std::bind(&Client::OnStateLoaded, this, _1, _2);
+  ADS_TRACE_ASYNC_BEGIN("Client::LoadState", this);
   ads_client_->Load(_client_name, callback);
 }
 
@@ -224,7 +236,7 @@ void Client::AppendCurrentTimeToCreativeSetHistory(
   SaveState();
 }
 
-const std::map<std::string, std::deque<uint64_t>>
+const std::map<std::string, std::deque<uint64_t>>&
     Client::GetCreativeSetHistory() const {
   return client_state_->creative_set_history;
 }
@@ -242,11 +254,62 @@ void Client::AppendCurrentTimeToCampaignHistory(
   SaveState();
 }
 
-const std::map<std::string, std::deque<uint64_t>>
+const std::map<std::string, std::deque<uint64_t>>&
     Client::GetCampaignHistory() const {
   return client_state_->campaign_history;
 }
 
+void Client::SetCatalogValidators(
+    const std::string& etag,
+    const std::string& last_modified) {
+  if (client_state_->catalog_etag == etag &&
+      client_state_->catalog_last_modified == last_modified) {
+    return;
+  }
+
+  client_state_->catalog_etag = etag;
+  client_state_->catalog_last_modified = last_modified;
+
+  SaveState();
+}
+
+const std::string Client::GetCatalogETag() const {
+  return client_state_->catalog_etag;
+}
+
+const std::string Client::GetCatalogLastModified() const {
+  return client_state_->catalog_last_modified;
+}
+
+void Client::SetBundleMetadata(const BundleState& state) {
+  if (client_state_->catalog_id == state.catalog_id &&
+      client_state_->catalog_version == state.catalog_version &&
+      client_state_->catalog_ping == state.catalog_ping &&
+      client_state_->catalog_last_updated_timestamp_in_seconds ==
+          state.catalog_last_updated_timestamp_in_seconds) {
+    return;
+  }
+
+  client_state_->catalog_id = state.catalog_id;
+  client_state_->catalog_version = state.catalog_version;
+  client_state_->catalog_ping = state.catalog_ping;
+  client_state_->catalog_last_updated_timestamp_in_seconds =
+      state.catalog_last_updated_timestamp_in_seconds;
+
+  SaveState();
+}
+
+std::unique_ptr<BundleState> Client::GetBundleMetadata() const {
+  auto state = std::make_unique<BundleState>();
+  state->catalog_id = client_state_->catalog_id;
+  state->catalog_version = client_state_->catalog_version;
+  state->catalog_ping = client_state_->catalog_ping;
+  state->catalog_last_updated_timestamp_in_seconds =
+      client_state_->catalog_last_updated_timestamp_in_seconds;
+
+  return state;
+}
+
 void Client::RemoveAllHistory() {
   BLOG(INFO) << "Removed all client state history";
 
@@ -258,6 +321,8 @@ void Client::RemoveAllHistory() {
 ///////////////////////////////////////////////////////////////////////////////
 
 void Client::OnStateSaved(const Result result) {
+  ADS_TRACE_ASYNC_END("Client::SaveState", this);
+
   if (result != SUCCESS) {
     BLOG(ERROR) << "Failed to save client state";
 
@@ -268,6 +333,9 @@ void Client::OnStateSaved(const Result result) {
 }
 
 void Client::OnStateLoaded(const Result result, const std::string& json) {
+  ADS_TRACE_ASYNC_END("Client::LoadState", this);
+  ADS_TRACE_EVENT("Client::OnStateLoaded");
+
   is_initialized_ = true;
   state_has_loaded_ = true;
 
@@ -277,7 +345,7 @@ void Client::OnStateLoaded(const Result result, const std::string& json) {
     client_state_.reset(new ClientState());
   } else {
     if (!FromJson(json)) {
-      BLOG(ERROR) << "Failed to parse client state: " << json;
+      BLOG(ERROR) << "Failed to parse client state";
 
       return;
     }
@@ -294,12 +362,12 @@ bool Client::FromJson(const std::string& json) {
   auto result = LoadFromJson(&state, json, &error_description);
   if (result != SUCCESS) {
     BLOG(ERROR) << "Failed to parse client JSON (" << error_description <<
-        "): " << json;
+        "): " << helper::JSON::GetSummary(json);
 
     return false;
   }
 
-  client_state_.reset(new ClientState(state));
+  client_state_.reset(new ClientState(std::move(state)));
 
   SaveState();
 
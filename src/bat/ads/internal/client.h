@@ -59,12 +59,23 @@ class Client {
   const std::deque<std::vector<double>> GetPageScoreHistory();
   void AppendCurrentTimeToCreativeSetHistory(
       const std::string& creative_set_id);
-  const std::map<std::string, std::deque<uint64_t>>
+  const std::map<std::string, std::deque<uint64_t>>&
       GetCreativeSetHistory() const;
   void AppendCurrentTimeToCampaignHistory(
       const std::string& campaign_id);
-  const std::map<std::string, std::deque<uint64_t>>
+  const std::map<std::string, std::deque<uint64_t>>&
       GetCampaignHistory() const;
+  void SetCatalogValidators(
+      const std::string& etag,
+      const std::string& last_modified);
+  const std::string GetCatalogETag() const;
+  const std::string GetCatalogLastModified() const;
+
+  // Saves the catalog id, version, ping and last updated timestamp of the
+  // specified bundle state, but not its categories, so that the bundle can be
+  // restored on startup without downloading the catalog, see |Bundle|
+  void SetBundleMetadata(const BundleState& state);
+  std::unique_ptr<BundleState> GetBundleMetadata() const;
 
   void RemoveAllHistory();
 
@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <utility>
+
 #include "bat/ads/internal/client_state.h"
 #include "bat/ads/internal/json_helper.h"
 #include "bat/ads/internal/static_values.h"
@@ -28,7 +30,13 @@ ClientState::ClientState() :
     search_activity(false),
     search_url(""),
     shop_activity(false),
-    shop_url("") {}
+    shop_url(""),
+    catalog_etag(""),
+    catalog_last_modified(""),
+    catalog_id(""),
+    catalog_version(0),
+    catalog_ping(0),
+    catalog_last_updated_timestamp_in_seconds(0) {}
 
 ClientState::ClientState(const ClientState& state) :
   ads_shown_history(state.ads_shown_history),
@@ -49,7 +57,20 @@ ClientState::ClientState(const ClientState& state) :
   search_activity(state.search_activity),
   search_url(state.search_url),
   shop_activity(state.shop_activity),
-  shop_url(state.shop_url) {}
+  shop_url(state.shop_url),
+  catalog_etag(state.catalog_etag),
+  catalog_last_modified(state.catalog_last_modified),
+  catalog_id(state.catalog_id),
+  catalog_version(state.catalog_version),
+  catalog_ping(state.catalog_ping),
+  catalog_last_updated_timestamp_in_seconds(
+      state.catalog_last_updated_timestamp_in_seconds) {}
+
+ClientState::ClientState(ClientState&& state) = default;
+
+ClientState& ClientState::operator=(const ClientState& state) = default;
+
+ClientState& ClientState::operator=(ClientState&& state) = default;
 
 ClientState::~ClientState() = default;
 
@@ -67,7 +88,7 @@ Result ClientState::FromJson(
 
   if (client.HasParseError()) {
     if (error_description) {
-      *error_description = helper::JSON::GetLastError(&client);
+      *error_description = helper::JSON::GetLastError(&client, json);
     }
 
     return FAILED;
@@ -132,7 +153,7 @@ Result ClientState::FromJson(
         page_scores.push_back(page_score.GetDouble());
       }
 
-      page_score_history.push_back(page_scores);
+      page_score_history.push_back(std::move(page_scores));
     }
   }
 
@@ -144,7 +165,8 @@ Result ClientState::FromJson(
       }
 
       std::string creative_set_id = history.name.GetString();
-      creative_set_history.insert({creative_set_id, timestamps_in_seconds});
+      creative_set_history.insert({creative_set_id,
+          std::move(timestamps_in_seconds)});
     }
   }
 
@@ -156,7 +178,8 @@ Result ClientState::FromJson(
       }
 
       std::string campaign_id = history.name.GetString();
-      campaign_history.insert({campaign_id, timestamps_in_seconds});
+      campaign_history.insert({campaign_id,
+          std::move(timestamps_in_seconds)});
     }
   }
 
@@ -180,6 +203,31 @@ Result ClientState::FromJson(
     shop_url = client["shopUrl"].GetString();
   }
 
+  if (client.HasMember("catalogETag")) {
+    catalog_etag = client["catalogETag"].GetString();
+  }
+
+  if (client.HasMember("catalogLastModified")) {
+    catalog_last_modified = client["catalogLastModified"].GetString();
+  }
+
+  if (client.HasMember("catalogId")) {
+    catalog_id = client["catalogId"].GetString();
+  }
+
+  if (client.HasMember("catalogVersion")) {
+    catalog_version = client["catalogVersion"].GetUint64();
+  }
+
+  if (client.HasMember("catalogPing")) {
+    catalog_ping = client["catalogPing"].GetUint64();
+  }
+
+  if (client.HasMember("catalogLastUpdatedTimestampInSeconds")) {
+    catalog_last_updated_timestamp_in_seconds =
+        client["catalogLastUpdatedTimestampInSeconds"].GetUint64();
+  }
+
   return SUCCESS;
 }
 
@@ -282,6 +330,24 @@ void SaveToJson(JsonWriter* writer, const ClientState& state) {
   writer->String("shopUrl");
   writer->String(state.shop_url.c_str());
 
+  writer->String("catalogETag");
+  writer->String(state.catalog_etag.c_str());
+
+  writer->String("catalogLastModified");
+  writer->String(state.catalog_last_modified.c_str());
+
+  writer->String("catalogId");
+  writer->String(state.catalog_id.c_str());
+
+  writer->String("catalogVersion");
+  writer->Uint64(state.catalog_version);
+
+  writer->String("catalogPing");
+  writer->Uint64(state.catalog_ping);
+
+  writer->String("catalogLastUpdatedTimestampInSeconds");
+  writer->Uint64(state.catalog_last_updated_timestamp_in_seconds);
+
   writer->EndObject();
 }
 
@@ -19,6 +19,9 @@ namespace ads {
 struct ClientState {
   ClientState();
   explicit ClientState(const ClientState& state);
+  ClientState(ClientState&& state);
+  ClientState& operator=(const ClientState& state);
+  ClientState& operator=(ClientState&& state);
   ~ClientState();
 
   const std::string ToJson();
@@ -45,6 +48,12 @@ struct ClientState {
   std::string search_url;
   bool shop_activity;
   std::string shop_url;
+  std::string catalog_etag;
+  std::string catalog_last_modified;
+  std::string catalog_id;
+  uint64_t catalog_version;
+  uint64_t catalog_ping;
+  uint64_t catalog_last_updated_timestamp_in_seconds;
 };
 
 }  // namespace ads
@@ -0,0 +1,64 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "bat/ads/internal/client_state.h"
+#include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/test_data_helper.h"
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace ads {
+
+namespace {
+
+// Returns a client state with |count| ads shown, each from its own creative
+// set and campaign, and a full page score history
+ClientState GetClientState(const int64_t count) {
+  ClientState client_state;
+  client_state.FromJson(helper::TestData::Load("client.json"));
+
+  const uint64_t timestamp_in_seconds = 13200000000;
+
+  for (int64_t i = 0; i < count; i++) {
+    auto id = std::to_string(i);
+    auto timestamp = timestamp_in_seconds + i;
+
+    client_state.ads_shown_history.push_back(timestamp);
+    client_state.ads_uuid_seen.insert({"uuid-" + id, 1});
+    client_state.creative_set_history["creative-set-" + id].push_back(
+        timestamp);
+    client_state.campaign_history["campaign-" + id].push_back(timestamp);
+  }
+
+  client_state.page_score_history.clear();
+  for (uint64_t i = 0; i < kMaximumEntriesInPageScoreHistory; i++) {
+    client_state.page_score_history.push_back(std::vector<double>(250, 0.1));
+  }
+
+  return client_state;
+}
+
+void BM_ClientStateToJson(benchmark::State& state) {
+  auto client_state = GetClientState(state.range(0));
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto json = client_state.ToJson();
+    bytes += json.size();
+    benchmark::DoNotOptimize(json);
+  }
+
+  state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ClientStateToJson)
+    ->RangeMultiplier(10)->Range(1, 10000);
+
+}  // namespace
+
+}  // namespace ads
@@ -0,0 +1,45 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/compression_helper.h"
+
+#include "third_party/zlib/google/compression_utils.h"
+
+namespace helper {
+
+bool Compression::IsGzipped(const std::string& data) {
+  if (data.size() < 2) {
+    return false;
+  }
+
+  return static_cast<unsigned char>(data[0]) == 0x1f &&
+      static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+bool Compression::GzipCompress(
+    const std::string& input,
+    std::string* output) {
+  if (!output) {
+    return false;
+  }
+
+  return compression::GzipCompress(input, output);
+}
+
+bool Compression::GzipUncompress(
+    const std::string& input,
+    std::string* output) {
+  if (!output) {
+    return false;
+  }
+
+  if (!IsGzipped(input)) {
+    return false;
+  }
+
+  return compression::GzipUncompress(input, output);
+}
+
+}  // namespace helper
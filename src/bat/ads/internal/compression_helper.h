@@ -0,0 +1,26 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_COMPRESSION_HELPER_H_
+#define BAT_ADS_INTERNAL_COMPRESSION_HELPER_H_
+
+#include <string>
+
+namespace helper {
+
+class Compression {
+ public:
+  // Returns true if the specified data starts with the gzip magic number. The
+  // Client may or may not have already decoded a "Content-Encoding: gzip"
+  // response, so the payload is sniffed rather than trusting the headers
+  static bool IsGzipped(const std::string& data);
+
+  static bool GzipCompress(const std::string& input, std::string* output);
+  static bool GzipUncompress(const std::string& input, std::string* output);
+};
+
+}  // namespace helper
+
+#endif  // BAT_ADS_INTERNAL_COMPRESSION_HELPER_H_
@@ -13,6 +13,12 @@ BlurInfo::BlurInfo() :
 BlurInfo::BlurInfo(const BlurInfo& info) :
     tab_id(info.tab_id) {}
 
+BlurInfo::BlurInfo(BlurInfo&& info) noexcept = default;
+
+BlurInfo& BlurInfo::operator=(const BlurInfo& info) = default;
+
+BlurInfo& BlurInfo::operator=(BlurInfo&& info) noexcept = default;
+
 BlurInfo::~BlurInfo() {}
 
 }  // namespace ads
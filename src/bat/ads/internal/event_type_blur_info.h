@@ -13,6 +13,9 @@ namespace ads {
 struct BlurInfo {
   BlurInfo();
   explicit BlurInfo(const BlurInfo& info);
+  BlurInfo(BlurInfo&& info) noexcept;
+  BlurInfo& operator=(const BlurInfo& info);
+  BlurInfo& operator=(BlurInfo&& info) noexcept;
   ~BlurInfo();
 
   int32_t tab_id;
@@ -13,6 +13,12 @@ DestroyInfo::DestroyInfo() :
 DestroyInfo::DestroyInfo(const DestroyInfo& info) :
     tab_id(info.tab_id) {}
 
+DestroyInfo::DestroyInfo(DestroyInfo&& info) noexcept = default;
+
+DestroyInfo& DestroyInfo::operator=(const DestroyInfo& info) = default;
+
+DestroyInfo& DestroyInfo::operator=(DestroyInfo&& info) noexcept = default;
+
 DestroyInfo::~DestroyInfo() {}
 
 }  // namespace ads
@@ -13,6 +13,9 @@ namespace ads {
 struct DestroyInfo {
   DestroyInfo();
   explicit DestroyInfo(const DestroyInfo& info);
+  DestroyInfo(DestroyInfo&& info) noexcept;
+  DestroyInfo& operator=(const DestroyInfo& info);
+  DestroyInfo& operator=(DestroyInfo&& info) noexcept;
   ~DestroyInfo();
 
   int32_t tab_id;
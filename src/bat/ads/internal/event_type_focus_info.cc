@@ -13,6 +13,12 @@ FocusInfo::FocusInfo() :
 FocusInfo::FocusInfo(const FocusInfo& info) :
     tab_id(info.tab_id) {}
 
+FocusInfo::FocusInfo(FocusInfo&& info) noexcept = default;
+
+FocusInfo& FocusInfo::operator=(const FocusInfo& info) = default;
+
+FocusInfo& FocusInfo::operator=(FocusInfo&& info) noexcept = default;
+
 FocusInfo::~FocusInfo() {}
 
 }  // namespace ads
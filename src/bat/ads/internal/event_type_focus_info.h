@@ -13,6 +13,9 @@ namespace ads {
 struct FocusInfo {
   FocusInfo();
   explicit FocusInfo(const FocusInfo& info);
+  FocusInfo(FocusInfo&& info) noexcept;
+  FocusInfo& operator=(const FocusInfo& info);
+  FocusInfo& operator=(FocusInfo&& info) noexcept;
   ~FocusInfo();
 
   int32_t tab_id;
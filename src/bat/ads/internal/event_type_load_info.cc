@@ -17,6 +17,12 @@ LoadInfo::LoadInfo(const LoadInfo& info) :
     tab_url(info.tab_url),
     tab_classification(info.tab_classification) {}
 
+LoadInfo::LoadInfo(LoadInfo&& info) noexcept = default;
+
+LoadInfo& LoadInfo::operator=(const LoadInfo& info) = default;
+
+LoadInfo& LoadInfo::operator=(LoadInfo&& info) noexcept = default;
+
 LoadInfo::~LoadInfo() {}
 
 }  // namespace ads
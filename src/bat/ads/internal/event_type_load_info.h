@@ -13,6 +13,9 @@ namespace ads {
 struct LoadInfo {
   LoadInfo();
   explicit LoadInfo(const LoadInfo& info);
+  LoadInfo(LoadInfo&& info) noexcept;
+  LoadInfo& operator=(const LoadInfo& info);
+  LoadInfo& operator=(LoadInfo&& info) noexcept;
   ~LoadInfo();
 
   int32_t tab_id;
@@ -0,0 +1,30 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/http_helper.h"
+
+#include "base/strings/string_util.h"
+
+namespace helper {
+
+std::string Http::GetHeaderValue(
+    const std::map<std::string, std::string>& headers,
+    const std::string& name) {
+  for (const auto& header : headers) {
+    if (base::EqualsCaseInsensitiveASCII(header.first, name)) {
+      return header.second;
+    }
+  }
+
+  return "";
+}
+
+std::string Http::BuildHeader(
+    const std::string& name,
+    const std::string& value) {
+  return name + ": " + value;
+}
+
+}  // namespace helper
@@ -0,0 +1,29 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_HTTP_HELPER_H_
+#define BAT_ADS_INTERNAL_HTTP_HELPER_H_
+
+#include <string>
+#include <map>
+
+namespace helper {
+
+class Http {
+ public:
+  // Returns the value for the specified header name, header names are matched
+  // case-insensitively as they may be normalized by the Client
+  static std::string GetHeaderValue(
+      const std::map<std::string, std::string>& headers,
+      const std::string& name);
+
+  static std::string BuildHeader(
+      const std::string& name,
+      const std::string& value);
+};
+
+}  // namespace helper
+
+#endif  // BAT_ADS_INTERNAL_HTTP_HELPER_H_
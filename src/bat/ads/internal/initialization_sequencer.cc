@@ -0,0 +1,121 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/initialization_sequencer.h"
+
+namespace ads {
+
+InitializationSequencer::Step::Step() :
+    dependencies({}),
+    callback(nullptr),
+    has_started(false),
+    has_completed(false) {}
+
+InitializationSequencer::Step::Step(const Step& step) = default;
+
+InitializationSequencer::Step::~Step() = default;
+
+///////////////////////////////////////////////////////////////////////////////
+
+InitializationSequencer::InitializationSequencer() :
+    is_started_(false) {}
+
+InitializationSequencer::~InitializationSequencer() = default;
+
+void InitializationSequencer::AddStep(
+    const InitializationStepType step,
+    const std::vector<InitializationStepType>& dependencies,
+    InitializationStepCallback callback) {
+  if (steps_.find(step) == steps_.end()) {
+    order_.push_back(step);
+  }
+
+  auto& new_step = steps_[step];
+  new_step.dependencies = dependencies;
+  new_step.callback = callback;
+  new_step.has_started = false;
+  new_step.has_completed = false;
+}
+
+void InitializationSequencer::Start() {
+  is_started_ = true;
+
+  RunReadySteps();
+}
+
+void InitializationSequencer::CompleteStep(const InitializationStepType step) {
+  auto iter = steps_.find(step);
+  if (iter == steps_.end() || iter->second.has_completed) {
+    return;
+  }
+
+  iter->second.has_completed = true;
+
+  RunReadySteps();
+}
+
+bool InitializationSequencer::HasCompleted(
+    const InitializationStepType step) const {
+  auto iter = steps_.find(step);
+  if (iter == steps_.end()) {
+    return false;
+  }
+
+  return iter->second.has_completed;
+}
+
+void InitializationSequencer::Reset() {
+  steps_.clear();
+  order_.clear();
+  is_started_ = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool InitializationSequencer::IsReady(const Step& step) const {
+  if (step.has_started) {
+    return false;
+  }
+
+  for (const auto& dependency : step.dependencies) {
+    if (!HasCompleted(dependency)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void InitializationSequencer::RunReadySteps() {
+  if (!is_started_) {
+    return;
+  }
+
+  // Callbacks may complete or reset steps synchronously, so the steps are
+  // searched again after running each callback
+  auto has_run_step = true;
+  while (has_run_step) {
+    has_run_step = false;
+
+    for (const auto step_type : order_) {
+      auto& step = steps_[step_type];
+      if (!IsReady(step)) {
+        continue;
+      }
+
+      step.has_started = true;
+
+      auto callback = step.callback;
+      if (callback) {
+        callback();
+      }
+
+      has_run_step = true;
+      break;
+    }
+  }
+}
+
+}  // namespace ads
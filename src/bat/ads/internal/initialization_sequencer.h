@@ -0,0 +1,78 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_INITIALIZATION_SEQUENCER_H_
+#define BAT_ADS_INTERNAL_INITIALIZATION_SEQUENCER_H_
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace ads {
+
+enum InitializationStepType {
+  LOAD_CLIENT_STATE_STEP,
+  DOWNLOAD_CATALOG_STEP,
+  INITIALIZE_STEP
+};
+
+using InitializationStepCallback = std::function<void()>;
+
+// Runs each initialization step as soon as the steps it depends on have
+// completed, so that independent asynchronous loads are in flight at the same
+// time rather than chained one after another. Steps run in the order they were
+// added when more than one is ready
+class InitializationSequencer {
+ public:
+  InitializationSequencer();
+  ~InitializationSequencer();
+
+  void AddStep(
+      const InitializationStepType step,
+      const std::vector<InitializationStepType>& dependencies,
+      InitializationStepCallback callback);
+
+  // Runs the steps which have no dependencies
+  void Start();
+
+  // Should be called once the work started by |step| has completed, runs the
+  // steps which were waiting on it. Completing a step more than once has no
+  // effect
+  void CompleteStep(const InitializationStepType step);
+
+  bool HasCompleted(const InitializationStepType step) const;
+
+  // Removes all steps, callbacks for steps in flight must not call
+  // |CompleteStep| after a reset
+  void Reset();
+
+ private:
+  struct Step {
+    Step();
+    Step(const Step& step);
+    ~Step();
+
+    std::vector<InitializationStepType> dependencies;
+    InitializationStepCallback callback;
+    bool has_started;
+    bool has_completed;
+  };
+
+  std::map<InitializationStepType, Step> steps_;
+  std::vector<InitializationStepType> order_;
+
+  bool is_started_;
+
+  bool IsReady(const Step& step) const;
+  void RunReadySteps();
+
+  // Not copyable, not assignable
+  InitializationSequencer(const InitializationSequencer&) = delete;
+  InitializationSequencer& operator=(const InitializationSequencer&) = delete;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_INITIALIZATION_SEQUENCER_H_
@@ -0,0 +1,115 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "bat/ads/internal/initialization_sequencer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class InitializationSequencerTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<InitializationSequencer> sequencer_;
+  std::string steps_run_;
+
+  InitializationSequencerTest() :
+      sequencer_(std::make_unique<InitializationSequencer>()) {
+    // You can do set-up work for each test here
+  }
+
+  ~InitializationSequencerTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  InitializationStepCallback RecordStep(const std::string& name) {
+    return [this, name]() {
+      steps_run_ += name;
+    };
+  }
+
+  void AddSteps() {
+    sequencer_->AddStep(LOAD_CLIENT_STATE_STEP, {}, RecordStep("A"));
+    sequencer_->AddStep(DOWNLOAD_CATALOG_STEP, {}, RecordStep("B"));
+    sequencer_->AddStep(INITIALIZE_STEP,
+        {LOAD_CLIENT_STATE_STEP, DOWNLOAD_CATALOG_STEP}, RecordStep("C"));
+  }
+};
+
+TEST_F(InitializationSequencerTest, StartRunsIndependentSteps) {
+  // Arrange
+  AddSteps();
+
+  // Act
+  sequencer_->Start();
+
+  // Assert
+  EXPECT_EQ("AB", steps_run_);
+}
+
+TEST_F(InitializationSequencerTest, StepRunsOnceAllDependenciesComplete) {
+  // Arrange
+  AddSteps();
+  sequencer_->Start();
+
+  // Act
+  sequencer_->CompleteStep(DOWNLOAD_CATALOG_STEP);
+  auto steps_run_after_first_dependency = steps_run_;
+  sequencer_->CompleteStep(LOAD_CLIENT_STATE_STEP);
+
+  // Assert
+  EXPECT_EQ("AB", steps_run_after_first_dependency);
+  EXPECT_EQ("ABC", steps_run_);
+}
+
+TEST_F(InitializationSequencerTest, CompletingStepTwiceHasNoEffect) {
+  // Arrange
+  AddSteps();
+  sequencer_->Start();
+  sequencer_->CompleteStep(LOAD_CLIENT_STATE_STEP);
+  sequencer_->CompleteStep(DOWNLOAD_CATALOG_STEP);
+
+  // Act
+  sequencer_->CompleteStep(DOWNLOAD_CATALOG_STEP);
+
+  // Assert
+  EXPECT_EQ("ABC", steps_run_);
+}
+
+TEST_F(InitializationSequencerTest, StepsCanCompleteSynchronously) {
+  // Arrange
+  sequencer_->AddStep(LOAD_CLIENT_STATE_STEP, {}, [this]() {
+    steps_run_ += "A";
+    sequencer_->CompleteStep(LOAD_CLIENT_STATE_STEP);
+  });
+  sequencer_->AddStep(INITIALIZE_STEP, {LOAD_CLIENT_STATE_STEP},
+      RecordStep("C"));
+
+  // Act
+  sequencer_->Start();
+
+  // Assert
+  EXPECT_EQ("AC", steps_run_);
+}
+
+TEST_F(InitializationSequencerTest, ResetRemovesSteps) {
+  // Arrange
+  AddSteps();
+  sequencer_->Start();
+
+  // Act
+  sequencer_->Reset();
+  sequencer_->CompleteStep(LOAD_CLIENT_STATE_STEP);
+  sequencer_->CompleteStep(DOWNLOAD_CATALOG_STEP);
+
+  // Assert
+  EXPECT_EQ("AB", steps_run_);
+  EXPECT_FALSE(sequencer_->HasCompleted(LOAD_CLIENT_STATE_STEP));
+}
+
+}  // namespace ads
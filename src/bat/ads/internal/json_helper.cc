@@ -3,10 +3,30 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <stdint.h>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 #include "bat/ads/internal/json_helper.h"
+#include "bat/ads/internal/static_values.h"
 
 namespace helper {
 
+namespace {
+
+uint64_t GetFnv1aHash(const std::string& value) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (const auto character : value) {
+    hash ^= static_cast<uint8_t>(character);
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+}  // namespace
+
 ads::Result JSON::Validate(
     rapidjson::Document* document,
     const std::string& json_schema) {
@@ -45,4 +65,40 @@ std::string JSON::GetLastError(rapidjson::Document* document) {
   return description + " (" + error_offset + ")";
 }
 
+std::string JSON::GetLastError(
+    rapidjson::Document* document,
+    const std::string& json) {
+  if (!document) {
+    return "Invalid document";
+  }
+
+  if (!document->HasParseError()) {
+    return "Does not match schema";
+  }
+
+  auto error_offset = std::min(document->GetErrorOffset(), json.size());
+  auto begin = error_offset - std::min(error_offset,
+      ads::kParseErrorContextLength);
+  auto end = std::min(error_offset + ads::kParseErrorContextLength,
+      json.size());
+
+  auto context = json.substr(begin, end - begin);
+  std::replace_if(context.begin(), context.end(), [](const char character) {
+    return static_cast<unsigned char>(character) < 0x20;
+  }, ' ');
+
+  return GetLastError(document) + " near \"" + context + "\"";
+}
+
+std::string JSON::GetSummary(const std::string& json) {
+  std::ostringstream summary;
+  summary << json.size() << " bytes, FNV-1a " << std::hex
+      << std::setfill('0') << std::setw(16) << GetFnv1aHash(json);
+  return summary.str();
+}
+
+size_t JSON::GetMemoryPoolChunkCapacity(const std::string& json) {
+  return std::max(json.size(), ads::kMinimumMemoryPoolChunkCapacity);
+}
+
 }  // namespace helper
@@ -6,10 +6,13 @@
 #ifndef BAT_ADS_INTERNAL_JSON_HELPER_H_
 #define BAT_ADS_INTERNAL_JSON_HELPER_H_
 
+#include <stddef.h>
 #include <string>
 
 #include "bat/ads/result.h"
 
+#include "bat/ads/internal/metrics.h"
+
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
 #include "rapidjson/stringbuffer.h"
@@ -24,6 +27,9 @@ struct AdInfo;
 struct NotificationInfo;
 struct ClientState;
 struct BundleState;
+struct DiagnosticsInfo;
+struct TraceEventInfo;
+class TraceLog;
 
 using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
 
@@ -33,6 +39,9 @@ void SaveToJson(JsonWriter* writer, const AdInfo& info);
 void SaveToJson(JsonWriter* writer, const NotificationInfo& info);
 void SaveToJson(JsonWriter* writer, const ClientState& state);
 void SaveToJson(JsonWriter* writer, const BundleState& state);
+void SaveToJson(JsonWriter* writer, const DiagnosticsInfo& info);
+void SaveToJson(JsonWriter* writer, const TraceEventInfo& info);
+void SaveToJson(JsonWriter* writer, const TraceLog& trace_log);
 
 template <typename T>
 void SaveToJson(const T& t, std::string* json) {
@@ -40,11 +49,15 @@ void SaveToJson(const T& t, std::string* json) {
     return;
   }
 
+  ADS_METRICS_SCOPED_TIMER(SERIALIZE_JSON_HISTOGRAM);
+
   rapidjson::StringBuffer buffer;
   JsonWriter writer(buffer);
 
   SaveToJson(&writer, t);
   *json = buffer.GetString();
+
+  ADS_METRICS_INCREMENT(JSON_BYTES_SERIALIZED_COUNTER, json->size());
 }
 
 template <typename T>
@@ -75,6 +88,23 @@ class JSON {
       const std::string& json_schema);
 
   static std::string GetLastError(rapidjson::Document* document);
+
+  // Returns the last error together with a bounded window of the specified
+  // JSON around the error offset, so that parse failures can be logged without
+  // the whole payload
+  static std::string GetLastError(
+      rapidjson::Document* document,
+      const std::string& json);
+
+  // Returns the size and a 64-bit FNV-1a hash of the specified JSON, which
+  // identify a payload in the log without copying it
+  static std::string GetSummary(const std::string& json);
+
+  // Returns the chunk capacity for a memory pool used to parse the specified
+  // JSON. Large documents, i.e. the catalog, are parsed into one or two large
+  // chunks rather than many default sized chunks, so that the DOM is allocated
+  // and freed in a handful of steps
+  static size_t GetMemoryPoolChunkCapacity(const std::string& json);
 };
 
 }  // namespace helper
@@ -0,0 +1,78 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "bat/ads/internal/client_state.h"
+#include "bat/ads/internal/json_helper.h"
+#include "bat/ads/internal/static_values.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class JsonHelperTest : public ::testing::Test {
+ protected:
+  JsonHelperTest() {
+    // You can do set-up work for each test here
+  }
+
+  ~JsonHelperTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+};
+
+TEST_F(JsonHelperTest, GetSummaryOfEmptyJson) {
+  // Arrange
+
+  // Act
+  auto summary = helper::JSON::GetSummary("");
+
+  // Assert
+  EXPECT_EQ("0 bytes, FNV-1a cbf29ce484222325", summary);
+}
+
+TEST_F(JsonHelperTest, GetSummary) {
+  // Arrange
+
+  // Act
+  auto summary = helper::JSON::GetSummary("{}");
+
+  // Assert
+  EXPECT_EQ("2 bytes, FNV-1a 08f44b07b5901a25", summary);
+}
+
+TEST_F(JsonHelperTest, GetLastErrorIsBoundedForLargePayloads) {
+  // Arrange
+  std::string json = "{\"adsShownHistory\":[" + std::string(1024 * 1024, ' ') +
+      "1,,2]}";
+
+  // Act
+  ClientState state;
+  std::string error_description;
+  auto result = state.FromJson(json, &error_description);
+
+  // Assert
+  EXPECT_EQ(FAILED, result);
+  EXPECT_NE(std::string::npos, error_description.find("1,,2]}"));
+  EXPECT_LT(error_description.size(), 4 * kParseErrorContextLength);
+}
+
+TEST_F(JsonHelperTest, GetLastErrorIncludesShortPayloads) {
+  // Arrange
+  std::string json = "{\"available\":tru}";
+
+  // Act
+  ClientState state;
+  std::string error_description;
+  state.FromJson(json, &error_description);
+
+  // Assert
+  EXPECT_NE(std::string::npos, error_description.find(json));
+}
+
+}  // namespace ads
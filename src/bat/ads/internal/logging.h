@@ -6,6 +6,9 @@
 #ifndef BAT_ADS_INTERNAL_LOGGING_H_
 #define BAT_ADS_INTERNAL_LOGGING_H_
 
+#include <ostream>
+
+#include "bat/ads/ads.h"
 #include "bat/ads/ads_client.h"
 
 #define ADS_LOG_INFO \
@@ -17,10 +20,32 @@
 #define ADS_LOG_ERROR \
   ads_client_->Log(__FILE__, __LINE__, ::ads::LogLevel::LOG_ERROR)
 
-#define BLOG(severity) ADS_LOG_ ## severity->stream()
+#define ADS_LOG_IS_ON(severity) \
+  (::ads::LogLevel::LOG_ ## severity <= \
+      ::ads::_log_level.load(std::memory_order_relaxed))
+
+// Log messages below |_log_level| neither request a log stream from the Client
+// nor evaluate their operands
+#define BLOG(severity) \
+  !ADS_LOG_IS_ON(severity) ? (void) 0 : \
+      ::ads::LogMessageVoidify() & ADS_LOG_ ## severity->stream()
 
 #if defined(ERROR)
 #define LOG_0 ADS_LOG_ERROR
 #endif
 
+namespace ads {
+
+// Used to ignore the log stream in |BLOG| so that both branches of the
+// conditional operator have type void. |operator&| has a lower precedence than
+// |operator<<| but higher than |?:|
+class LogMessageVoidify {
+ public:
+  LogMessageVoidify() = default;
+
+  void operator&(std::ostream&) {}
+};
+
+}  // namespace ads
+
 #endif  // BAT_ADS_INTERNAL_LOGGING_H_
@@ -0,0 +1,91 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/logging.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class LoggingTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<MockAdsClient> mock_ads_client_;
+  AdsClient* ads_client_;  // NOT OWNED
+  LogLevel log_level_;
+  int evaluated_operands_;
+
+  LoggingTest() :
+      mock_ads_client_(std::make_unique<MockAdsClient>()),
+      ads_client_(mock_ads_client_.get()),
+      log_level_(_log_level),
+      evaluated_operands_(0) {
+    // You can do set-up work for each test here
+  }
+
+  ~LoggingTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+    _log_level = log_level_;
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  std::string EvaluateOperand() {
+    evaluated_operands_++;
+    return "operand";
+  }
+};
+
+TEST_F(LoggingTest, DisabledLevelDoesNotEvaluateOperands) {
+  // Arrange
+  _log_level = LOG_WARNING;
+
+  // Act
+  BLOG(INFO) << EvaluateOperand();
+
+  // Assert
+  EXPECT_EQ(0, evaluated_operands_);
+}
+
+TEST_F(LoggingTest, DisabledLevelDoesNotRequestLogStream) {
+  // Arrange
+  _log_level = LOG_ERROR;
+  ads_client_ = nullptr;
+
+  // Act
+  BLOG(WARNING) << EvaluateOperand();
+
+  // Assert
+  EXPECT_EQ(0, evaluated_operands_);
+}
+
+TEST_F(LoggingTest, EnabledLevelEvaluatesOperands) {
+  // Arrange
+  _log_level = LOG_WARNING;
+
+  // Act
+  BLOG(WARNING) << EvaluateOperand();
+  BLOG(ERROR) << EvaluateOperand();
+
+  // Assert
+  EXPECT_EQ(2, evaluated_operands_);
+}
+
+TEST_F(LoggingTest, LevelCanBeChangedAtRuntime) {
+  // Arrange
+  _log_level = LOG_ERROR;
+  BLOG(INFO) << EvaluateOperand();
+
+  // Act
+  _log_level = LOG_INFO;
+  BLOG(INFO) << EvaluateOperand();
+
+  // Assert
+  EXPECT_EQ(1, evaluated_operands_);
+}
+
+}  // namespace ads
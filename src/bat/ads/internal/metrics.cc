@@ -0,0 +1,217 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/no_destructor.h"
+
+namespace ads {
+
+namespace {
+
+const char* const kCounterNames[] = {
+  "ads_shown",
+  "catalog_bytes_parsed",
+  "client_state_bytes_saved",
+  "json_bytes_serialized"
+};
+
+const char* const kHistogramNames[] = {
+  "classify_page",
+  "parse_catalog",
+  "build_bundle",
+  "get_unseen_ads",
+  "select_ad",
+  "show_ad",
+  "save_client_state",
+  "serialize_json"
+};
+
+static_assert(sizeof(kCounterNames) / sizeof(kCounterNames[0]) ==
+    METRICS_COUNTER_TYPE_COUNT, "Each counter must have a name");
+static_assert(sizeof(kHistogramNames) / sizeof(kHistogramNames[0]) ==
+    METRICS_HISTOGRAM_TYPE_COUNT, "Each histogram must have a name");
+
+const size_t kSubBucketBits = 3;
+const size_t kSubBucketCount = 1 << kSubBucketBits;
+
+size_t Log2Floor(uint64_t value) {
+  size_t log = 0;
+  for (size_t shift = 32; shift > 0; shift >>= 1) {
+    if (value >> shift) {
+      value >>= shift;
+      log += shift;
+    }
+  }
+
+  return log;
+}
+
+uint64_t GetPercentile(
+    const HistogramInfo& histogram,
+    const double percentile) {
+  if (histogram.count == 0) {
+    return 0;
+  }
+
+  auto rank = static_cast<uint64_t>(
+      std::ceil(percentile * histogram.count / 100.0));
+  rank = std::max<uint64_t>(rank, 1);
+
+  uint64_t count = 0;
+  for (const auto& bucket : histogram.buckets) {
+    count += bucket.second;
+    if (count >= rank) {
+      return bucket.first;
+    }
+  }
+
+  return histogram.buckets.rbegin()->first;
+}
+
+}  // namespace
+
+constexpr size_t Metrics::kBucketCount;
+
+Metrics::Metrics() {
+  Reset();
+}
+
+Metrics::~Metrics() = default;
+
+Metrics* Metrics::GetInstance() {
+  static base::NoDestructor<Metrics> instance;
+  return instance.get();
+}
+
+void Metrics::Increment(
+    const MetricsCounterType counter,
+    const uint64_t value) {
+  counters_[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+void Metrics::Record(
+    const MetricsHistogramType histogram,
+    const base::TimeDelta& latency) {
+  auto value = static_cast<uint64_t>(
+      std::max<int64_t>(latency.InMicroseconds(), 0));
+
+  auto& recorded_histogram = histograms_[histogram];
+  recorded_histogram.count.fetch_add(1, std::memory_order_relaxed);
+  recorded_histogram.sum.fetch_add(value, std::memory_order_relaxed);
+  recorded_histogram.buckets[GetBucketIndex(value)].fetch_add(1,
+      std::memory_order_relaxed);
+
+  auto max = recorded_histogram.max.load(std::memory_order_relaxed);
+  while (value > max && !recorded_histogram.max.compare_exchange_weak(max,
+      value, std::memory_order_relaxed)) {
+  }
+}
+
+std::unique_ptr<DiagnosticsInfo> Metrics::GetDiagnostics() const {
+  auto diagnostics = std::make_unique<DiagnosticsInfo>();
+
+  for (size_t i = 0; i < counters_.size(); i++) {
+    diagnostics->counters[kCounterNames[i]] =
+        counters_[i].load(std::memory_order_relaxed);
+  }
+
+  for (size_t i = 0; i < histograms_.size(); i++) {
+    const auto& recorded_histogram = histograms_[i];
+
+    HistogramInfo histogram;
+    histogram.sum = recorded_histogram.sum.load(std::memory_order_relaxed);
+    histogram.max = recorded_histogram.max.load(std::memory_order_relaxed);
+
+    // Count the buckets rather than reading |count| so that percentiles are
+    // consistent with the buckets while values are being recorded
+    for (size_t j = 0; j < kBucketCount; j++) {
+      auto count = recorded_histogram.buckets[j].load(
+          std::memory_order_relaxed);
+      if (count == 0) {
+        continue;
+      }
+
+      histogram.buckets[GetBucketLowerBound(j)] = count;
+      histogram.count += count;
+    }
+
+    histogram.p50 = GetPercentile(histogram, 50);
+    histogram.p90 = GetPercentile(histogram, 90);
+    histogram.p99 = GetPercentile(histogram, 99);
+
+    diagnostics->histograms[kHistogramNames[i]] = histogram;
+  }
+
+  return diagnostics;
+}
+
+void Metrics::Reset() {
+  for (auto& counter : counters_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+
+  for (auto& histogram : histograms_) {
+    histogram.count.store(0, std::memory_order_relaxed);
+    histogram.sum.store(0, std::memory_order_relaxed);
+    histogram.max.store(0, std::memory_order_relaxed);
+
+    for (auto& bucket : histogram.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+size_t Metrics::GetBucketIndex(const uint64_t value) {
+  if (value < kSubBucketCount) {
+    return value;
+  }
+
+  auto exponent = Log2Floor(value);
+  auto sub_bucket = (value >> (exponent - kSubBucketBits)) &
+      (kSubBucketCount - 1);
+  auto index = kSubBucketCount +
+      (exponent - kSubBucketBits) * kSubBucketCount + sub_bucket;
+
+  return std::min(index, kBucketCount - 1);
+}
+
+uint64_t Metrics::GetBucketLowerBound(const size_t index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+
+  auto exponent = (index - kSubBucketCount) / kSubBucketCount + kSubBucketBits;
+  auto sub_bucket = (index - kSubBucketCount) % kSubBucketCount;
+
+  return static_cast<uint64_t>(kSubBucketCount + sub_bucket) <<
+      (exponent - kSubBucketBits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ScopedMetricsTimer::ScopedMetricsTimer(const MetricsHistogramType histogram) :
+    histogram_(histogram),
+    start_(base::TimeTicks::Now()) {
+}
+
+ScopedMetricsTimer::~ScopedMetricsTimer() {
+  Metrics::GetInstance()->Record(histogram_,
+      base::TimeTicks::Now() - start_ - excluded_);
+}
+
+ScopedMetricsTimer::Exclusion::Exclusion(ScopedMetricsTimer* timer) :
+    timer_(timer),
+    start_(base::TimeTicks::Now()) {
+}
+
+ScopedMetricsTimer::Exclusion::~Exclusion() {
+  timer_->excluded_ += base::TimeTicks::Now() - start_;
+}
+
+}  // namespace ads
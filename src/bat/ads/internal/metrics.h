@@ -0,0 +1,134 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_METRICS_H_
+#define BAT_ADS_INTERNAL_METRICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "bat/ads/diagnostics_info.h"
+
+#include "base/time/time.h"
+
+// Hot path instrumentation compiles to nothing unless the library is built
+// with |bat_ads_enable_metrics|
+#if defined(BAT_ADS_ENABLE_METRICS)
+#define ADS_METRICS_SCOPED_TIMER(histogram) \
+    ads::ScopedMetricsTimer scoped_metrics_timer(histogram)
+#define ADS_METRICS_EXCLUDE_FROM_SCOPED_TIMER() \
+    ads::ScopedMetricsTimer::Exclusion scoped_metrics_timer_exclusion( \
+        &scoped_metrics_timer)
+#define ADS_METRICS_INCREMENT(counter, value) \
+    ads::Metrics::GetInstance()->Increment(counter, value)
+#else
+#define ADS_METRICS_SCOPED_TIMER(histogram)
+#define ADS_METRICS_EXCLUDE_FROM_SCOPED_TIMER()
+#define ADS_METRICS_INCREMENT(counter, value)
+#endif
+
+namespace ads {
+
+enum MetricsCounterType {
+  ADS_SHOWN_COUNTER,
+  CATALOG_BYTES_PARSED_COUNTER,
+  CLIENT_STATE_BYTES_SAVED_COUNTER,
+  JSON_BYTES_SERIALIZED_COUNTER,
+  METRICS_COUNTER_TYPE_COUNT
+};
+
+enum MetricsHistogramType {
+  CLASSIFY_PAGE_HISTOGRAM,
+  PARSE_CATALOG_HISTOGRAM,
+  BUILD_BUNDLE_HISTOGRAM,
+  GET_UNSEEN_ADS_HISTOGRAM,
+  SELECT_AD_HISTOGRAM,
+  SHOW_AD_HISTOGRAM,
+  SAVE_CLIENT_STATE_HISTOGRAM,
+  SERIALIZE_JSON_HISTOGRAM,
+  METRICS_HISTOGRAM_TYPE_COUNT
+};
+
+// Process wide counters and latency histograms. Recording is lock-free and
+// may happen on any thread. Histograms are log-linear, with 8 linear buckets
+// for each power of two, so recorded latencies are accurate to within 12.5%
+class Metrics {
+ public:
+  Metrics();
+  ~Metrics();
+
+  static Metrics* GetInstance();
+
+  void Increment(const MetricsCounterType counter, const uint64_t value);
+
+  void Record(
+      const MetricsHistogramType histogram,
+      const base::TimeDelta& latency);
+
+  std::unique_ptr<DiagnosticsInfo> GetDiagnostics() const;
+
+  void Reset();
+
+  static size_t GetBucketIndex(const uint64_t value);
+  static uint64_t GetBucketLowerBound(const size_t index);
+
+  // Latencies of 2^36 microseconds and above, i.e. over 19 hours, fall in the
+  // last bucket
+  static constexpr size_t kBucketCount = 8 + 8 * 33;
+
+ private:
+  struct Histogram {
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets;
+  };
+
+  std::array<std::atomic<uint64_t>, METRICS_COUNTER_TYPE_COUNT> counters_;
+  std::array<Histogram, METRICS_HISTOGRAM_TYPE_COUNT> histograms_;
+
+  // Not copyable, not assignable
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+};
+
+// Records the lifetime of the scope in the specified histogram
+class ScopedMetricsTimer {
+ public:
+  explicit ScopedMetricsTimer(const MetricsHistogramType histogram);
+  ~ScopedMetricsTimer();
+
+  // Excludes the lifetime of a nested scope from |timer|, i.e. time spent
+  // calling back into the caller
+  class Exclusion {
+   public:
+    explicit Exclusion(ScopedMetricsTimer* timer);
+    ~Exclusion();
+
+   private:
+    ScopedMetricsTimer* timer_;  // NOT OWNED
+    base::TimeTicks start_;
+
+    // Not copyable, not assignable
+    Exclusion(const Exclusion&) = delete;
+    Exclusion& operator=(const Exclusion&) = delete;
+  };
+
+ private:
+  MetricsHistogramType histogram_;
+  base::TimeTicks start_;
+  base::TimeDelta excluded_;
+
+  // Not copyable, not assignable
+  ScopedMetricsTimer(const ScopedMetricsTimer&) = delete;
+  ScopedMetricsTimer& operator=(const ScopedMetricsTimer&) = delete;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_METRICS_H_
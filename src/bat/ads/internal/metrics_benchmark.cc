@@ -0,0 +1,36 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+
+#include "bat/ads/internal/metrics.h"
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace ads {
+
+namespace {
+
+void BM_RecordLatency(benchmark::State& state) {
+  Metrics metrics;
+
+  int64_t latency = 0;
+  for (auto _ : state) {
+    metrics.Record(CLASSIFY_PAGE_HISTOGRAM,
+        base::TimeDelta::FromMicroseconds(latency++ % 100000));
+  }
+}
+BENCHMARK(BM_RecordLatency)->ThreadRange(1, 8);
+
+void BM_ScopedMetricsTimer(benchmark::State& state) {
+  for (auto _ : state) {
+    ADS_METRICS_SCOPED_TIMER(CLASSIFY_PAGE_HISTOGRAM);
+  }
+}
+BENCHMARK(BM_ScopedMetricsTimer);
+
+}  // namespace
+
+}  // namespace ads
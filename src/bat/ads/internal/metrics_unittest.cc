@@ -0,0 +1,138 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+
+#include "bat/ads/internal/metrics.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class MetricsTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<Metrics> metrics_;
+
+  MetricsTest() :
+      metrics_(std::make_unique<Metrics>()) {
+    // You can do set-up work for each test here
+  }
+
+  ~MetricsTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  void RecordLatencies(const int64_t count) {
+    for (int64_t i = 1; i <= count; i++) {
+      metrics_->Record(CLASSIFY_PAGE_HISTOGRAM,
+          base::TimeDelta::FromMicroseconds(i));
+    }
+  }
+};
+
+TEST_F(MetricsTest, BucketsAreExactForSmallValues) {
+  // Arrange
+
+  // Act
+
+  // Assert
+  for (uint64_t value = 0; value < 16; value++) {
+    auto index = Metrics::GetBucketIndex(value);
+    EXPECT_EQ(value, Metrics::GetBucketLowerBound(index));
+  }
+}
+
+TEST_F(MetricsTest, BucketsAreWithinPrecision) {
+  // Arrange
+
+  // Act
+
+  // Assert
+  for (uint64_t value = 1; value < (1ULL << 36); value = value * 3 / 2 + 1) {
+    auto index = Metrics::GetBucketIndex(value);
+    ASSERT_LT(index, Metrics::kBucketCount);
+
+    auto lower_bound = Metrics::GetBucketLowerBound(index);
+    EXPECT_LE(lower_bound, value);
+    EXPECT_GE(lower_bound, value - value / 8);
+
+    if (index + 1 < Metrics::kBucketCount) {
+      EXPECT_GT(Metrics::GetBucketLowerBound(index + 1), value);
+    }
+  }
+}
+
+TEST_F(MetricsTest, LargeValuesFallInLastBucket) {
+  // Arrange
+
+  // Act
+  auto index = Metrics::GetBucketIndex(UINT64_MAX);
+
+  // Assert
+  EXPECT_EQ(Metrics::kBucketCount - 1, index);
+}
+
+TEST_F(MetricsTest, Record) {
+  // Arrange
+  RecordLatencies(100);
+
+  // Act
+  auto diagnostics = metrics_->GetDiagnostics();
+
+  // Assert
+  const auto& histogram = diagnostics->histograms["classify_page"];
+  EXPECT_EQ(100UL, histogram.count);
+  EXPECT_EQ(5050UL, histogram.sum);
+  EXPECT_EQ(100UL, histogram.max);
+  EXPECT_NEAR(50, histogram.p50, 50 / 8);
+  EXPECT_NEAR(90, histogram.p90, 90 / 8);
+  EXPECT_NEAR(99, histogram.p99, 99 / 8);
+}
+
+TEST_F(MetricsTest, Increment) {
+  // Arrange
+  metrics_->Increment(ADS_SHOWN_COUNTER, 1);
+  metrics_->Increment(ADS_SHOWN_COUNTER, 2);
+
+  // Act
+  auto diagnostics = metrics_->GetDiagnostics();
+
+  // Assert
+  EXPECT_EQ(3UL, diagnostics->counters["ads_shown"]);
+  EXPECT_EQ(0UL, diagnostics->counters["json_bytes_serialized"]);
+}
+
+TEST_F(MetricsTest, DiagnosticsIncludeEveryMetric) {
+  // Arrange
+
+  // Act
+  auto diagnostics = metrics_->GetDiagnostics();
+
+  // Assert
+  EXPECT_EQ(static_cast<size_t>(METRICS_COUNTER_TYPE_COUNT),
+      diagnostics->counters.size());
+  EXPECT_EQ(static_cast<size_t>(METRICS_HISTOGRAM_TYPE_COUNT),
+      diagnostics->histograms.size());
+}
+
+TEST_F(MetricsTest, Reset) {
+  // Arrange
+  RecordLatencies(100);
+  metrics_->Increment(ADS_SHOWN_COUNTER, 1);
+
+  // Act
+  metrics_->Reset();
+
+  // Assert
+  auto diagnostics = metrics_->GetDiagnostics();
+  EXPECT_EQ(0UL, diagnostics->counters["ads_shown"]);
+  EXPECT_EQ(0UL, diagnostics->histograms["classify_page"].count);
+  EXPECT_TRUE(diagnostics->histograms["classify_page"].buckets.empty());
+}
+
+}  // namespace ads
@@ -0,0 +1,112 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+
+#include "bat/ads/internal/retry_policy.h"
+#include "bat/ads/internal/logging.h"
+
+#include "base/rand_util.h"
+
+namespace ads {
+
+RetryPolicy::RetryPolicy(
+    AdsClient* ads_client,
+    const uint64_t initial_delay_in_seconds,
+    const uint64_t maximum_delay_in_seconds,
+    const uint64_t maximum_failures,
+    const uint64_t cooldown_in_seconds) :
+    initial_delay_in_seconds_(std::max<uint64_t>(initial_delay_in_seconds, 1)),
+    maximum_delay_in_seconds_(std::max(maximum_delay_in_seconds,
+        initial_delay_in_seconds_)),
+    maximum_failures_(maximum_failures),
+    cooldown_in_seconds_(cooldown_in_seconds),
+    failures_(0),
+    is_circuit_open_(false),
+    ads_client_(ads_client) {
+}
+
+RetryPolicy::~RetryPolicy() = default;
+
+uint64_t RetryPolicy::RecordFailure() {
+  failures_++;
+
+  if (!ads_client_->IsNetworkConnectionAvailable()) {
+    BLOG(INFO) << "Circuit breaker open: Network connection not available";
+
+    is_circuit_open_ = true;
+    return GetCooldownDelay();
+  }
+
+  if (failures_ >= maximum_failures_) {
+    if (!is_circuit_open_) {
+      BLOG(WARNING) << "Circuit breaker open after " << failures_
+          << " consecutive failures";
+    }
+
+    is_circuit_open_ = true;
+    return GetCooldownDelay();
+  }
+
+  is_circuit_open_ = false;
+
+  // Full jitter, a zero second delay is rounded up so that the next attempt is
+  // never scheduled in the same tick as the failure
+  auto delay = GetRandomDelay(GetBackoffDelay());
+  return std::max<uint64_t>(delay, 1);
+}
+
+void RetryPolicy::RecordSuccess() {
+  if (is_circuit_open_) {
+    BLOG(INFO) << "Circuit breaker closed";
+  }
+
+  Reset();
+}
+
+void RetryPolicy::Reset() {
+  failures_ = 0;
+  is_circuit_open_ = false;
+}
+
+uint64_t RetryPolicy::GetFailures() const {
+  return failures_;
+}
+
+bool RetryPolicy::IsCircuitOpen() const {
+  return is_circuit_open_;
+}
+
+uint64_t RetryPolicy::GetRandomDelay(const uint64_t maximum_delay) {
+  return static_cast<uint64_t>(
+      base::RandInt(0, static_cast<int>(maximum_delay)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t RetryPolicy::GetBackoffDelay() const {
+  auto delay = initial_delay_in_seconds_;
+
+  for (uint64_t i = 1; i < failures_; i++) {
+    if (delay >= maximum_delay_in_seconds_ / 2) {
+      return maximum_delay_in_seconds_;
+    }
+
+    delay *= 2;
+  }
+
+  return std::min(delay, maximum_delay_in_seconds_);
+}
+
+uint64_t RetryPolicy::GetCooldownDelay() {
+  // Only half of the cooldown is jittered so that probes are spread out
+  // without ever probing sooner than half of the cooldown
+  auto half_cooldown = cooldown_in_seconds_ / 2;
+  auto delay = cooldown_in_seconds_ - half_cooldown +
+      GetRandomDelay(half_cooldown);
+  return std::max<uint64_t>(delay, 1);
+}
+
+}  // namespace ads
@@ -0,0 +1,73 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_RETRY_POLICY_H_
+#define BAT_ADS_INTERNAL_RETRY_POLICY_H_
+
+#include <stdint.h>
+
+#include "bat/ads/ads_client.h"
+
+namespace ads {
+
+// Exponential backoff with full jitter for retrying requests to the Ads Serve.
+// Delays are capped so that clients keep retrying at a bounded interval during
+// a long outage, and jittered so that clients do not retry in lockstep when
+// the Ads Serve recovers.
+//
+// The circuit breaker opens once |maximum_failures| consecutive attempts have
+// failed, or immediately if there is no network connection. While open, the
+// next attempt is a single probe after a jittered cooldown. The policy is
+// closed again by calling |RecordSuccess|
+class RetryPolicy {
+ public:
+  RetryPolicy(
+      AdsClient* ads_client,
+      const uint64_t initial_delay_in_seconds,
+      const uint64_t maximum_delay_in_seconds,
+      const uint64_t maximum_failures,
+      const uint64_t cooldown_in_seconds);
+
+  virtual ~RetryPolicy();
+
+  // Should be called after an attempt has failed. Returns the number of
+  // seconds to wait before the next attempt
+  uint64_t RecordFailure();
+
+  // Should be called after an attempt has succeeded
+  void RecordSuccess();
+
+  void Reset();
+
+  uint64_t GetFailures() const;
+  bool IsCircuitOpen() const;
+
+ protected:
+  // Returns a uniformly distributed random delay between 0 and |maximum_delay|
+  // inclusive. Overridden by tests to make retry timing deterministic
+  virtual uint64_t GetRandomDelay(const uint64_t maximum_delay);
+
+ private:
+  uint64_t GetBackoffDelay() const;
+  uint64_t GetCooldownDelay();
+
+  uint64_t initial_delay_in_seconds_;
+  uint64_t maximum_delay_in_seconds_;
+  uint64_t maximum_failures_;
+  uint64_t cooldown_in_seconds_;
+
+  uint64_t failures_;
+  bool is_circuit_open_;
+
+  AdsClient* ads_client_;  // NOT OWNED
+
+  // Not copyable, not assignable
+  RetryPolicy(const RetryPolicy&) = delete;
+  RetryPolicy& operator=(const RetryPolicy&) = delete;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_RETRY_POLICY_H_
@@ -0,0 +1,245 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <vector>
+#include <map>
+#include <memory>
+#include <random>
+#include <algorithm>
+
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/retry_policy.h"
+
+#include "base/time/time.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+namespace ads {
+
+static const uint64_t kInitialDelayInSeconds = 60;
+static const uint64_t kMaximumDelayInSeconds = 60 * 60;
+static const uint64_t kMaximumFailures = 8;
+static const uint64_t kCooldownInSeconds = 2 * 60 * 60;
+
+// Replaces the random source with a seeded generator so that retry timing is
+// reproducible, or with the upper bound so that the backoff can be asserted
+class TestRetryPolicy : public RetryPolicy {
+ public:
+  TestRetryPolicy(
+      AdsClient* ads_client,
+      const uint64_t seed,
+      const bool is_jittered) :
+      RetryPolicy(ads_client, kInitialDelayInSeconds, kMaximumDelayInSeconds,
+          kMaximumFailures, kCooldownInSeconds),
+      generator_(seed),
+      is_jittered_(is_jittered) {}
+
+  ~TestRetryPolicy() override = default;
+
+ protected:
+  uint64_t GetRandomDelay(const uint64_t maximum_delay) override {
+    if (!is_jittered_) {
+      return maximum_delay;
+    }
+
+    std::uniform_int_distribution<uint64_t> distribution(0, maximum_delay);
+    return distribution(generator_);
+  }
+
+ private:
+  std::mt19937_64 generator_;
+  bool is_jittered_;
+};
+
+class RetryPolicyTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<MockAdsClient> mock_ads_client_;
+
+  RetryPolicyTest() :
+      mock_ads_client_(std::make_unique<MockAdsClient>()) {
+    // You can do set-up work for each test here
+  }
+
+  ~RetryPolicyTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // If the constructor and destructor are not enough for setting up and
+  // cleaning up each test, you can use the following methods
+
+  void SetUp() override {
+    // Code here will be called immediately after the constructor (right before
+    // each test)
+
+    ON_CALL(*mock_ads_client_, IsNetworkConnectionAvailable())
+        .WillByDefault(Return(true));
+  }
+
+  void TearDown() override {
+    // Code here will be called immediately after each test (right before the
+    // destructor)
+  }
+
+  // Objects declared here can be used by all tests in the test case
+
+  // Simulates |clients| retrying against an Ads Serve which is unavailable
+  // for |outage_in_seconds| using a virtual clock, and returns the number of
+  // requests received by the Ads Serve for each minute after it recovered
+  std::map<uint64_t, uint64_t> SimulateOutage(
+      const uint64_t clients,
+      const uint64_t outage_in_seconds) {
+    std::map<uint64_t, uint64_t> requests_per_minute;
+
+    for (uint64_t client = 0; client < clients; client++) {
+      TestRetryPolicy retry_policy(mock_ads_client_.get(), client, true);
+
+      // All clients poll at the same moment when the outage starts
+      uint64_t now_in_seconds = 0;
+      while (now_in_seconds < outage_in_seconds) {
+        now_in_seconds += retry_policy.RecordFailure();
+      }
+
+      retry_policy.RecordSuccess();
+
+      auto minute = (now_in_seconds - outage_in_seconds) /
+          base::Time::kSecondsPerMinute;
+      requests_per_minute[minute]++;
+    }
+
+    return requests_per_minute;
+  }
+};
+
+TEST_F(RetryPolicyTest, RecordFailure_BackoffIsCapped) {
+  // Arrange
+  TestRetryPolicy retry_policy(mock_ads_client_.get(), 0, false);
+
+  // Act
+  std::vector<uint64_t> delays;
+  for (uint64_t i = 0; i < kMaximumFailures - 1; i++) {
+    delays.push_back(retry_policy.RecordFailure());
+  }
+
+  // Assert
+  std::vector<uint64_t> expected_delays = {
+    60, 120, 240, 480, 960, 1920, 3600
+  };
+
+  EXPECT_EQ(expected_delays, delays);
+  EXPECT_FALSE(retry_policy.IsCircuitOpen());
+}
+
+TEST_F(RetryPolicyTest, RecordFailure_DelayIsJittered) {
+  // Arrange
+  TestRetryPolicy retry_policy(mock_ads_client_.get(), 1, true);
+
+  // Act
+  std::vector<uint64_t> delays;
+  for (uint64_t i = 0; i < kMaximumFailures - 1; i++) {
+    delays.push_back(retry_policy.RecordFailure());
+  }
+
+  // Assert
+  uint64_t backoff = kInitialDelayInSeconds;
+  for (const auto delay : delays) {
+    EXPECT_GE(delay, 1ULL);
+    EXPECT_LE(delay, std::min(backoff, kMaximumDelayInSeconds));
+    backoff *= 2;
+  }
+}
+
+TEST_F(RetryPolicyTest, RecordFailure_OpensCircuitAfterMaximumFailures) {
+  // Arrange
+  TestRetryPolicy retry_policy(mock_ads_client_.get(), 2, true);
+
+  for (uint64_t i = 0; i < kMaximumFailures - 1; i++) {
+    retry_policy.RecordFailure();
+  }
+
+  // Act
+  auto delay = retry_policy.RecordFailure();
+
+  // Assert
+  EXPECT_TRUE(retry_policy.IsCircuitOpen());
+  EXPECT_GE(delay, kCooldownInSeconds / 2);
+  EXPECT_LE(delay, kCooldownInSeconds);
+}
+
+TEST_F(RetryPolicyTest, RecordFailure_OpensCircuitWhenOffline) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, IsNetworkConnectionAvailable())
+      .WillOnce(Return(false));
+
+  TestRetryPolicy retry_policy(mock_ads_client_.get(), 3, true);
+
+  // Act
+  auto delay = retry_policy.RecordFailure();
+
+  // Assert
+  EXPECT_TRUE(retry_policy.IsCircuitOpen());
+  EXPECT_GE(delay, kCooldownInSeconds / 2);
+  EXPECT_LE(delay, kCooldownInSeconds);
+}
+
+TEST_F(RetryPolicyTest, RecordSuccess_ClosesCircuitAndResetsBackoff) {
+  // Arrange
+  TestRetryPolicy retry_policy(mock_ads_client_.get(), 0, false);
+
+  for (uint64_t i = 0; i < kMaximumFailures; i++) {
+    retry_policy.RecordFailure();
+  }
+
+  // Act
+  retry_policy.RecordSuccess();
+
+  // Assert
+  EXPECT_FALSE(retry_policy.IsCircuitOpen());
+  EXPECT_EQ(0ULL, retry_policy.GetFailures());
+  EXPECT_EQ(kInitialDelayInSeconds, retry_policy.RecordFailure());
+}
+
+TEST_F(RetryPolicyTest, Simulation_IsDeterministic) {
+  // Arrange
+  const uint64_t clients = 100;
+  const uint64_t outage_in_seconds = 6 * base::Time::kSecondsPerHour;
+
+  // Act
+  auto requests_per_minute = SimulateOutage(clients, outage_in_seconds);
+
+  // Assert
+  EXPECT_EQ(requests_per_minute, SimulateOutage(clients, outage_in_seconds));
+}
+
+TEST_F(RetryPolicyTest, Simulation_RecoveryDoesNotStampede) {
+  // Arrange
+  const uint64_t clients = 1000;
+  const uint64_t outage_in_seconds = 6 * base::Time::kSecondsPerHour;
+
+  // Act
+  auto requests_per_minute = SimulateOutage(clients, outage_in_seconds);
+
+  // Assert
+  uint64_t requests = 0;
+  uint64_t peak_requests_per_minute = 0;
+  uint64_t last_minute = 0;
+  for (const auto& minute : requests_per_minute) {
+    requests += minute.second;
+    peak_requests_per_minute = std::max(peak_requests_per_minute,
+        minute.second);
+    last_minute = minute.first;
+  }
+
+  EXPECT_EQ(clients, requests);
+
+  // Without jitter every client would retry in the same minute
+  EXPECT_LT(peak_requests_per_minute, clients / 10);
+
+  // Every client has recovered within one cooldown of the Ads Serve recovering
+  EXPECT_LE(last_minute, kCooldownInSeconds / base::Time::kSecondsPerMinute);
+}
+
+}  // namespace ads
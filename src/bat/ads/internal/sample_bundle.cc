@@ -0,0 +1,49 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <utility>
+
+#include "bat/ads/internal/sample_bundle.h"
+
+#include "base/rand_util.h"
+
+namespace ads {
+
+SampleBundle::SampleBundle(
+    std::map<std::string, std::vector<AdInfo>> categories) {
+  categories_.reserve(categories.size());
+  ads_.reserve(categories.size());
+
+  for (auto& category : categories) {
+    if (category.second.empty()) {
+      continue;
+    }
+
+    categories_.push_back(category.first);
+    ads_.push_back(std::move(category.second));
+  }
+}
+
+SampleBundle::~SampleBundle() = default;
+
+bool SampleBundle::IsEmpty() const {
+  return categories_.empty();
+}
+
+const AdInfo* SampleBundle::GetRandomAd(std::string* category) const {
+  if (IsEmpty()) {
+    return nullptr;
+  }
+
+  auto category_rand = base::RandInt(0, categories_.size() - 1);
+  const auto& ads = ads_.at(category_rand);
+
+  auto ad_rand = base::RandInt(0, ads.size() - 1);
+
+  *category = categories_.at(category_rand);
+  return &ads.at(ad_rand);
+}
+
+}  // namespace ads
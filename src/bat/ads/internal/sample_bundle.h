@@ -0,0 +1,43 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_SAMPLE_BUNDLE_H_
+#define BAT_ADS_INTERNAL_SAMPLE_BUNDLE_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "bat/ads/ad_info.h"
+
+namespace ads {
+
+// Indexes the sample bundle categories so that sample ads can be picked in
+// constant time without reloading and parsing the sample bundle. Categories
+// without ads are not indexed
+class SampleBundle {
+ public:
+  explicit SampleBundle(
+      std::map<std::string, std::vector<AdInfo>> categories);
+  ~SampleBundle();
+
+  bool IsEmpty() const;
+
+  // Picks a random category and then a random ad from that category, returns
+  // nullptr if there are no ads
+  const AdInfo* GetRandomAd(std::string* category) const;
+
+ private:
+  std::vector<std::string> categories_;
+  std::vector<std::vector<AdInfo>> ads_;
+
+  // Not copyable, not assignable
+  SampleBundle(const SampleBundle&) = delete;
+  SampleBundle& operator=(const SampleBundle&) = delete;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_SAMPLE_BUNDLE_H_
@@ -0,0 +1,98 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "bat/ads/internal/sample_bundle.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class SampleBundleTest : public ::testing::Test {
+ protected:
+  SampleBundleTest() {
+    // You can do set-up work for each test here
+  }
+
+  ~SampleBundleTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  AdInfo BuildAd(const std::string& uuid) {
+    AdInfo ad;
+    ad.uuid = uuid;
+    return ad;
+  }
+};
+
+TEST_F(SampleBundleTest, GetRandomAd) {
+  // Arrange
+  std::map<std::string, std::vector<AdInfo>> categories = {
+    {"technology & computing", {BuildAd("1"), BuildAd("2")}},
+    {"travel", {BuildAd("3")}}
+  };
+
+  SampleBundle sample_bundle(categories);
+
+  std::set<std::string> uuids;
+
+  // Act
+  for (int i = 0; i < 1000; i++) {
+    std::string category;
+    auto* ad = sample_bundle.GetRandomAd(&category);
+    ASSERT_NE(nullptr, ad);
+    ASSERT_TRUE(categories.find(category) != categories.end());
+
+    uuids.insert(ad->uuid);
+  }
+
+  // Assert
+  std::set<std::string> expected_uuids = {"1", "2", "3"};
+  EXPECT_EQ(expected_uuids, uuids);
+}
+
+TEST_F(SampleBundleTest, GetRandomAd_SkipsCategoriesWithoutAds) {
+  // Arrange
+  std::map<std::string, std::vector<AdInfo>> categories = {
+    {"technology & computing", {}},
+    {"travel", {BuildAd("1")}}
+  };
+
+  SampleBundle sample_bundle(categories);
+
+  // Act
+  for (int i = 0; i < 100; i++) {
+    std::string category;
+    auto* ad = sample_bundle.GetRandomAd(&category);
+
+    // Assert
+    ASSERT_NE(nullptr, ad);
+    EXPECT_EQ("travel", category);
+  }
+}
+
+TEST_F(SampleBundleTest, GetRandomAd_Empty) {
+  // Arrange
+  std::map<std::string, std::vector<AdInfo>> categories = {
+    {"travel", {}}
+  };
+
+  SampleBundle sample_bundle(categories);
+
+  // Act
+  std::string category;
+  auto* ad = sample_bundle.GetRandomAd(&category);
+
+  // Assert
+  EXPECT_TRUE(sample_bundle.IsEmpty());
+  EXPECT_EQ(nullptr, ad);
+}
+
+}  // namespace ads
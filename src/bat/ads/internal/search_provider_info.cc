@@ -29,6 +29,15 @@ SearchProviderInfo::SearchProviderInfo(const SearchProviderInfo& info) :
     search_template(info.search_template),
     is_always_classed_as_a_search(info.is_always_classed_as_a_search) {}
 
+SearchProviderInfo::SearchProviderInfo(
+    SearchProviderInfo&& info) noexcept = default;
+
+SearchProviderInfo& SearchProviderInfo::operator=(
+    const SearchProviderInfo& info) = default;
+
+SearchProviderInfo& SearchProviderInfo::operator=(
+    SearchProviderInfo&& info) noexcept = default;
+
 SearchProviderInfo::~SearchProviderInfo() {}
 
 }  // namespace ads
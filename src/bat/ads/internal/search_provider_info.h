@@ -19,6 +19,9 @@ struct SearchProviderInfo {
       const std::string& search_template,
       bool is_always_classed_as_a_search);
   SearchProviderInfo(const SearchProviderInfo& info);
+  SearchProviderInfo(SearchProviderInfo&& info) noexcept;
+  SearchProviderInfo& operator=(const SearchProviderInfo& info);
+  SearchProviderInfo& operator=(SearchProviderInfo&& info) noexcept;
   ~SearchProviderInfo();
 
   std::string name;
@@ -0,0 +1,39 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "bat/ads/internal/search_providers.h"
+
+#include "third_party/google_benchmark/src/include/benchmark/benchmark.h"
+
+namespace ads {
+
+namespace {
+
+void BM_IsSearchEngine(benchmark::State& state) {
+  const std::vector<std::string> urls = {
+    "https://duckduckgo.com/?q=brave",
+    "https://www.google.com/search?q=brave",
+    "https://search.yahoo.com/search?p=brave",
+    "https://brave.com/",
+    "https://www.example.com/some/path?query=string",
+    "https://github.com/brave-intl/bat-native-ads"
+  };
+
+  size_t index = 0;
+  for (auto _ : state) {
+    auto is_search_engine =
+        SearchProviders::IsSearchEngine(urls.at(index % urls.size()));
+    benchmark::DoNotOptimize(is_search_engine);
+    index++;
+  }
+}
+BENCHMARK(BM_IsSearchEngine);
+
+}  // namespace
+
+}  // namespace ads
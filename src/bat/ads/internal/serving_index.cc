@@ -0,0 +1,263 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "bat/ads/internal/serving_index.h"
+#include "bat/ads/internal/ad_eligibility.h"
+#include "bat/ads/internal/metrics.h"
+#include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/time_helper.h"
+
+#include "base/rand_util.h"
+
+namespace ads {
+
+ServingIndex::ServingIndex(std::shared_ptr<const BundleState> bundle_state) :
+    bundle_state_(std::move(bundle_state)) {
+  for (const auto& category : bundle_state_->categories) {
+    for (const auto& ad : category.second) {
+      auto creative_set = AddCreativeSet(ad);
+      auto campaign = AddCampaign(ad);
+      auto weight = GetWeight(ad);
+
+      for (const auto& region : ad.regions) {
+        auto& candidates = candidates_[{region, category.first}];
+        candidates.ads.push_back(&ad);
+        candidates.creative_sets.push_back(creative_set);
+        candidates.campaigns.push_back(campaign);
+        candidates.weights.push_back(weight);
+      }
+    }
+  }
+
+  for (auto& candidates : candidates_) {
+    candidates.second.alias_table = AliasTable(candidates.second.weights);
+  }
+
+  for (const auto& campaign : campaigns_) {
+    if (campaign.start_timestamp_in_seconds != 0) {
+      flight_boundaries_.push_back(campaign.start_timestamp_in_seconds);
+    }
+
+    if (campaign.end_timestamp_in_seconds !=
+        std::numeric_limits<uint64_t>::max()) {
+      flight_boundaries_.push_back(campaign.end_timestamp_in_seconds);
+    }
+  }
+
+  std::sort(flight_boundaries_.begin(), flight_boundaries_.end());
+  flight_boundaries_.erase(std::unique(flight_boundaries_.begin(),
+      flight_boundaries_.end()), flight_boundaries_.end());
+}
+
+ServingIndex::~ServingIndex() = default;
+
+std::shared_ptr<const BundleState> ServingIndex::GetBundleState() const {
+  return bundle_state_;
+}
+
+bool ServingIndex::HasAds(
+    const std::string& region,
+    const std::string& category) const {
+  return GetCandidates(region, category) != nullptr;
+}
+
+const AdInfo* ServingIndex::SelectAd(
+    const std::string& region,
+    const std::string& category,
+    const AdEligibility& eligibility) const {
+  ADS_METRICS_SCOPED_TIMER(SELECT_AD_HISTOGRAM);
+
+  auto* candidates = GetCandidates(region, category);
+  if (!candidates) {
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < kMaximumAdSelectionAttempts; i++) {
+    auto index = candidates->alias_table.Sample();
+    if (eligibility.IsEligible(candidates->creative_sets.at(index),
+        candidates->campaigns.at(index))) {
+      return candidates->ads.at(index);
+    }
+  }
+
+  return SelectEligibleAd(*candidates, eligibility);
+}
+
+const std::vector<ServingIndex::CreativeSet>&
+ServingIndex::GetCreativeSets() const {
+  return creative_sets_;
+}
+
+const std::vector<ServingIndex::Campaign>& ServingIndex::GetCampaigns() const {
+  return campaigns_;
+}
+
+bool ServingIndex::GetCreativeSetIndex(
+    const std::string& creative_set_id,
+    uint32_t* index) const {
+  auto it = creative_set_indexes_.find(creative_set_id);
+  if (it == creative_set_indexes_.end()) {
+    return false;
+  }
+
+  *index = it->second;
+  return true;
+}
+
+bool ServingIndex::GetCampaignIndex(
+    const std::string& campaign_id,
+    uint32_t* index) const {
+  auto it = campaign_indexes_.find(campaign_id);
+  if (it == campaign_indexes_.end()) {
+    return false;
+  }
+
+  *index = it->second;
+  return true;
+}
+
+uint64_t ServingIndex::GetNextFlightBoundary(
+    const uint64_t now_in_seconds) const {
+  auto it = std::upper_bound(flight_boundaries_.begin(),
+      flight_boundaries_.end(), now_in_seconds);
+  if (it == flight_boundaries_.end()) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+
+  return *it;
+}
+
+double ServingIndex::GetWeight(const AdInfo& ad) {
+  // Campaigns with a higher daily cap are paced to be shown more often
+  if (ad.daily_cap == 0) {
+    return 1.0;
+  }
+
+  return ad.daily_cap;
+}
+
+// static
+ServingIndex::Campaign ServingIndex::GetCampaign(const AdInfo& ad) {
+  uint64_t start_timestamp_in_seconds;
+  if (!helper::Time::FromUTCString(ad.start_timestamp,
+      &start_timestamp_in_seconds)) {
+    start_timestamp_in_seconds = 0;
+  }
+
+  uint64_t end_timestamp_in_seconds;
+  if (!helper::Time::FromUTCString(ad.end_timestamp,
+      &end_timestamp_in_seconds)) {
+    end_timestamp_in_seconds = std::numeric_limits<uint64_t>::max();
+  }
+
+  return {ad.campaign_id, ad.daily_cap, start_timestamp_in_seconds,
+      end_timestamp_in_seconds};
+}
+
+const AdInfo* ServingIndex::SelectWeightedAd(const std::vector<AdInfo>& ads) {
+  if (ads.empty()) {
+    return nullptr;
+  }
+
+  double total_weight = 0.0;
+  for (const auto& ad : ads) {
+    total_weight += GetWeight(ad);
+  }
+
+  auto target_weight = base::RandDouble() * total_weight;
+
+  for (const auto& ad : ads) {
+    target_weight -= GetWeight(ad);
+    if (target_weight < 0.0) {
+      return &ad;
+    }
+  }
+
+  return &ads.back();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const ServingIndex::Candidates* ServingIndex::GetCandidates(
+    const std::string& region,
+    const std::string& category) const {
+  auto it = candidates_.find({region, category});
+  if (it == candidates_.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+const AdInfo* ServingIndex::SelectEligibleAd(
+    const Candidates& candidates,
+    const AdEligibility& eligibility) const {
+  auto size = candidates.ads.size();
+
+  double total_weight = 0.0;
+  for (size_t i = 0; i < size; i++) {
+    if (!eligibility.IsEligible(candidates.creative_sets[i],
+        candidates.campaigns[i])) {
+      continue;
+    }
+
+    total_weight += candidates.weights[i];
+  }
+
+  if (total_weight <= 0.0) {
+    return nullptr;
+  }
+
+  auto target_weight = base::RandDouble() * total_weight;
+
+  const AdInfo* ad = nullptr;
+  for (size_t i = 0; i < size; i++) {
+    if (!eligibility.IsEligible(candidates.creative_sets[i],
+        candidates.campaigns[i])) {
+      continue;
+    }
+
+    ad = candidates.ads[i];
+
+    target_weight -= candidates.weights[i];
+    if (target_weight < 0.0) {
+      break;
+    }
+  }
+
+  return ad;
+}
+
+uint32_t ServingIndex::AddCreativeSet(const AdInfo& ad) {
+  auto index = static_cast<uint32_t>(creative_sets_.size());
+
+  auto it = creative_set_indexes_.insert({ad.creative_set_id, index});
+  if (!it.second) {
+    return it.first->second;
+  }
+
+  creative_sets_.push_back({ad.creative_set_id, ad.per_day, ad.total_max});
+
+  return index;
+}
+
+uint32_t ServingIndex::AddCampaign(const AdInfo& ad) {
+  auto index = static_cast<uint32_t>(campaigns_.size());
+
+  auto it = campaign_indexes_.insert({ad.campaign_id, index});
+  if (!it.second) {
+    return it.first->second;
+  }
+
+  campaigns_.push_back(GetCampaign(ad));
+
+  return index;
+}
+
+}  // namespace ads
@@ -0,0 +1,136 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_SERVING_INDEX_H_
+#define BAT_ADS_INTERNAL_SERVING_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <utility>
+
+#include "bat/ads/ad_info.h"
+#include "bat/ads/bundle_state.h"
+
+#include "bat/ads/internal/alias_table.h"
+
+namespace ads {
+
+class AdEligibility;
+
+// Indexes the ads of a bundle state by region and category so that an ad can
+// be selected without copying ads. Ads are weighted by the daily cap of their
+// campaign, and selected in constant time using an alias table per region and
+// category. Ineligible ads are rejected and another ad is sampled, falling
+// back to a weighted scan of the eligible ads if too many ads are rejected.
+//
+// Creative sets and campaigns are assigned dense ids in the order they are
+// first seen, so that their eligibility can be tracked in bitsets, see
+// |AdEligibility|
+class ServingIndex {
+ public:
+  struct CreativeSet {
+    std::string creative_set_id;
+    unsigned int per_day;
+    unsigned int total_max;
+  };
+
+  // Flight windows are parsed once when the serving index is built, campaigns
+  // without a valid start or end are not bounded by it
+  struct Campaign {
+    std::string campaign_id;
+    unsigned int daily_cap;
+    uint64_t start_timestamp_in_seconds;
+    uint64_t end_timestamp_in_seconds;
+  };
+
+  explicit ServingIndex(std::shared_ptr<const BundleState> bundle_state);
+  ~ServingIndex();
+
+  std::shared_ptr<const BundleState> GetBundleState() const;
+
+  bool HasAds(
+      const std::string& region,
+      const std::string& category) const;
+
+  // Returns the selected ad, or nullptr if there are no eligible ads.
+  // |eligibility| must have been updated for this serving index
+  const AdInfo* SelectAd(
+      const std::string& region,
+      const std::string& category,
+      const AdEligibility& eligibility) const;
+
+  // Creative sets and campaigns indexed by dense id
+  const std::vector<CreativeSet>& GetCreativeSets() const;
+  const std::vector<Campaign>& GetCampaigns() const;
+
+  // Returns false if the creative set or campaign is not in the bundle
+  bool GetCreativeSetIndex(
+      const std::string& creative_set_id,
+      uint32_t* index) const;
+  bool GetCampaignIndex(
+      const std::string& campaign_id,
+      uint32_t* index) const;
+
+  // Returns the first campaign start or end after |now_in_seconds|, or the
+  // maximum timestamp if no campaigns start or end after |now_in_seconds|
+  uint64_t GetNextFlightBoundary(const uint64_t now_in_seconds) const;
+
+  static double GetWeight(const AdInfo& ad);
+
+  // Returns the campaign of |ad| with its flight window parsed
+  static Campaign GetCampaign(const AdInfo& ad);
+
+  // Selects an ad from |ads| with probability proportional to its weight, see
+  // |GetWeight|, so that ads requested from the Client using |GetAds| are
+  // paced in the same way as ads selected from the serving index. Returns
+  // nullptr if |ads| is empty
+  static const AdInfo* SelectWeightedAd(const std::vector<AdInfo>& ads);
+
+ private:
+  struct Candidates {
+    std::vector<const AdInfo*> ads;
+    std::vector<uint32_t> creative_sets;
+    std::vector<uint32_t> campaigns;
+    std::vector<double> weights;
+    AliasTable alias_table;
+  };
+
+  const Candidates* GetCandidates(
+      const std::string& region,
+      const std::string& category) const;
+
+  const AdInfo* SelectEligibleAd(
+      const Candidates& candidates,
+      const AdEligibility& eligibility) const;
+
+  uint32_t AddCreativeSet(const AdInfo& ad);
+  uint32_t AddCampaign(const AdInfo& ad);
+
+  std::shared_ptr<const BundleState> bundle_state_;
+
+  std::map<std::pair<std::string, std::string>, Candidates> candidates_;
+
+  std::vector<CreativeSet> creative_sets_;
+  std::unordered_map<std::string, uint32_t> creative_set_indexes_;
+
+  std::vector<Campaign> campaigns_;
+  std::unordered_map<std::string, uint32_t> campaign_indexes_;
+
+  // Sorted and unique campaign starts and ends
+  std::vector<uint64_t> flight_boundaries_;
+
+  // Not copyable, not assignable
+  ServingIndex(const ServingIndex&) = delete;
+  ServingIndex& operator=(const ServingIndex&) = delete;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_SERVING_INDEX_H_
@@ -0,0 +1,223 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <vector>
+#include <map>
+#include <memory>
+
+#include "bat/ads/bundle_state.h"
+
+#include "bat/ads/internal/ad_eligibility.h"
+#include "bat/ads/internal/serving_index.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+static const unsigned int kMaximumImpressions = 100;
+static const uint64_t kNowInSeconds = 1000000;
+
+class ServingIndexTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<ServingIndex> serving_index_;
+  AdEligibility eligibility_;
+
+  ServingIndexTest() {
+    // You can do set-up work for each test here
+  }
+
+  ~ServingIndexTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // If the constructor and destructor are not enough for setting up and
+  // cleaning up each test, you can use the following methods
+
+  void SetUp() override {
+    // Code here will be called immediately after the constructor (right before
+    // each test)
+
+    auto bundle_state = std::make_shared<BundleState>();
+    bundle_state->catalog_id = "catalog";
+    bundle_state->categories = {
+      {"travel", {
+        BuildAd("1", "campaign-1", 1, {"US", "GB"}),
+        BuildAd("2", "campaign-2", 9, {"US"})
+      }},
+      {"travel-hotels", {
+        BuildAd("3", "campaign-3", 0, {"GB"})
+      }}
+    };
+
+    serving_index_ = std::make_shared<ServingIndex>(bundle_state);
+  }
+
+  void TearDown() override {
+    // Code here will be called immediately after each test (right before the
+    // destructor)
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  AdInfo BuildAd(
+      const std::string& uuid,
+      const std::string& campaign_id,
+      const unsigned int daily_cap,
+      const std::vector<std::string>& regions) {
+    AdInfo ad;
+    ad.uuid = uuid;
+    ad.creative_set_id = "creative-set-" + uuid;
+    ad.campaign_id = campaign_id;
+    ad.daily_cap = daily_cap;
+    ad.per_day = kMaximumImpressions;
+    ad.total_max = kMaximumImpressions;
+    ad.regions = regions;
+    return ad;
+  }
+
+  std::map<std::string, int> SelectAds(
+      const std::string& region,
+      const std::string& category,
+      const int count) {
+    std::map<std::string, int> selections;
+
+    for (int i = 0; i < count; i++) {
+      auto* ad = serving_index_->SelectAd(region, category, eligibility_);
+      if (!ad) {
+        continue;
+      }
+
+      selections[ad->uuid]++;
+    }
+
+    return selections;
+  }
+};
+
+TEST_F(ServingIndexTest, HasAds) {
+  // Arrange
+
+  // Act
+
+  // Assert
+  EXPECT_TRUE(serving_index_->HasAds("US", "travel"));
+  EXPECT_TRUE(serving_index_->HasAds("GB", "travel-hotels"));
+  EXPECT_FALSE(serving_index_->HasAds("US", "travel-hotels"));
+  EXPECT_FALSE(serving_index_->HasAds("US", "sports"));
+}
+
+TEST_F(ServingIndexTest, AssignsDenseIds) {
+  // Arrange
+  uint32_t creative_set;
+  uint32_t campaign;
+
+  // Act
+  auto has_creative_set =
+      serving_index_->GetCreativeSetIndex("creative-set-3", &creative_set);
+  auto has_campaign = serving_index_->GetCampaignIndex("campaign-3", &campaign);
+
+  // Assert
+  EXPECT_EQ(3UL, serving_index_->GetCreativeSets().size());
+  EXPECT_EQ(3UL, serving_index_->GetCampaigns().size());
+
+  ASSERT_TRUE(has_creative_set);
+  EXPECT_EQ("creative-set-3",
+      serving_index_->GetCreativeSets().at(creative_set).creative_set_id);
+
+  ASSERT_TRUE(has_campaign);
+  EXPECT_EQ("campaign-3",
+      serving_index_->GetCampaigns().at(campaign).campaign_id);
+}
+
+TEST_F(ServingIndexTest, SelectAd_FiltersByRegion) {
+  // Arrange
+  eligibility_.Update(serving_index_, {}, {}, kNowInSeconds);
+
+  // Act
+  auto selections = SelectAds("GB", "travel", 100);
+
+  // Assert
+  std::map<std::string, int> expected_selections = {{"1", 100}};
+  EXPECT_EQ(expected_selections, selections);
+}
+
+TEST_F(ServingIndexTest, SelectAd_WeightsByDailyCap) {
+  // Arrange
+  eligibility_.Update(serving_index_, {}, {}, kNowInSeconds);
+
+  // Act
+  auto selections = SelectAds("US", "travel", 10000);
+
+  // Assert
+  EXPECT_NEAR(1000, selections["1"], 300);
+  EXPECT_NEAR(9000, selections["2"], 300);
+}
+
+TEST_F(ServingIndexTest, SelectWeightedAd_WeightsByDailyCap) {
+  // Arrange
+  std::vector<AdInfo> ads = {
+    BuildAd("1", "campaign-1", 1, {"US"}),
+    BuildAd("2", "campaign-2", 9, {"US"})
+  };
+
+  // Act
+  std::map<std::string, int> selections;
+  for (int i = 0; i < 10000; i++) {
+    auto* ad = ServingIndex::SelectWeightedAd(ads);
+    selections[ad->uuid]++;
+  }
+
+  // Assert
+  EXPECT_NEAR(1000, selections["1"], 300);
+  EXPECT_NEAR(9000, selections["2"], 300);
+}
+
+TEST_F(ServingIndexTest, SelectWeightedAd_NoAds) {
+  // Arrange
+  std::vector<AdInfo> ads;
+
+  // Act
+  auto* ad = ServingIndex::SelectWeightedAd(ads);
+
+  // Assert
+  EXPECT_EQ(nullptr, ad);
+}
+
+TEST_F(ServingIndexTest, SelectAd_RejectsIneligibleAds) {
+  // Arrange
+  AdHistory creative_set_history = {
+    {"creative-set-2", std::deque<uint64_t>(kMaximumImpressions, 0)}
+  };
+
+  eligibility_.Update(serving_index_, creative_set_history, {},
+      kNowInSeconds);
+
+  // Act
+  auto selections = SelectAds("US", "travel", 1000);
+
+  // Assert
+  std::map<std::string, int> expected_selections = {{"1", 1000}};
+  EXPECT_EQ(expected_selections, selections);
+}
+
+TEST_F(ServingIndexTest, SelectAd_NoEligibleAds) {
+  // Arrange
+  AdHistory campaign_history = {
+    {"campaign-1", std::deque<uint64_t>(2, kNowInSeconds)},
+    {"campaign-2", std::deque<uint64_t>(10, kNowInSeconds)}
+  };
+
+  eligibility_.Update(serving_index_, {}, campaign_history, kNowInSeconds);
+
+  // Act
+  auto* ad = serving_index_->SelectAd("US", "travel", eligibility_);
+
+  // Assert
+  EXPECT_EQ(nullptr, ad);
+}
+
+}  // namespace ads
@@ -6,6 +6,7 @@
 #ifndef BAT_ADS_INTERNAL_STATIC_VALUES_H_
 #define BAT_ADS_INTERNAL_STATIC_VALUES_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "base/time/time.h"
@@ -34,6 +35,39 @@ static const uint64_t kDeliverNotificationsAfterSeconds =
 
 static const uint64_t kDefaultCatalogPing = 2 * base::Time::kSecondsPerHour;
 
+static const uint64_t kRetryDownloadingCatalogAfterSeconds =
+    base::Time::kSecondsPerMinute;
+static const uint64_t kRetryDownloadingCatalogOnMobileAfterSeconds =
+    2 * base::Time::kSecondsPerMinute;
+static const uint64_t kMaximumRetryDownloadingCatalogAfterSeconds =
+    base::Time::kSecondsPerHour;
+static const uint64_t kMaximumCatalogDownloadFailures = 8;
+static const uint64_t kCatalogCircuitBreakerCooldownInSeconds =
+    kDefaultCatalogPing;
+
+static const size_t kMinimumMemoryPoolChunkCapacity = 64 * 1024;
+
+// Number of characters either side of a JSON parse error that are included in
+// the error description
+static const size_t kParseErrorContextLength = 32;
+
+static const size_t kMaximumValuesForLinearDedup = 8;
+
+static const size_t kBundleStateCategoriesBatchSize = 500;
+
+static const size_t kMaximumAdSelectionAttempts = 8;
+
+// Number of user models kept in memory for recently used locales
+static const size_t kUserModelCacheSize = 2;
+
+// User models which failed to load are not requested again for this long
+static const uint64_t kRetryLoadingUserModelAfterSeconds =
+    5 * base::Time::kSecondsPerMinute;
+
+// Pages visited while the user model is loading are classified once it has
+// loaded, older pages are dropped if more pages are visited
+static const size_t kMaximumPagesToClassifyWhileLoadingUserModel = 10;
+
 static char kDefaultLanguageCode[] = "en";
 static char kDefaultCountryCode[] = "US";
 
@@ -0,0 +1,402 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/synthetic_data_generator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "bat/ads/internal/campaign_info.h"
+#include "bat/ads/internal/catalog_state_writer.h"
+#include "bat/ads/internal/static_values.h"
+
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "base/time/time.h"
+
+namespace ads {
+
+namespace {
+
+const uint64_t kSecondsPerDay =
+    base::Time::kHoursPerDay * base::Time::kSecondsPerHour;
+
+const char kStartAt[] = "2019-01-01T00:00:00.000Z";
+const char kEndAt[] = "2099-12-31T23:59:59.999Z";
+
+const char* const kGeoTargetCodes[] = {
+  "US", "GB", "DE", "FR", "CA", "JP", "AU", "BR", "IN", "ES", "IT", "NL"
+};
+
+const char* const kSegments[] = {
+  "Technology & Computing",
+  "Travel",
+  "Sports",
+  "Food & Drink",
+  "Personal Finance",
+  "Health & Fitness",
+  "Automotive",
+  "Arts & Entertainment"
+};
+
+const char* const kSubsegments[][3] = {
+  {"Software", "Hardware", "Internet"},
+  {"Hotels", "Air Travel", "Beaches"},
+  {"Football", "Tennis", "Cycling"},
+  {"Cooking", "Restaurants", "Coffee"},
+  {"Banking", "Investing", "Insurance"},
+  {"Nutrition", "Exercise", "Yoga"},
+  {"Electric Vehicles", "Car Rental", "Motorcycles"},
+  {"Movies", "Music", "Books"}
+};
+
+const size_t kSegmentCount = sizeof(kSegments) / sizeof(kSegments[0]);
+const size_t kSubsegmentCount = sizeof(kSubsegments[0]) /
+    sizeof(kSubsegments[0][0]);
+
+const char* const kFillerWords[] = {
+  "the", "and", "with", "for", "new", "best", "today", "read", "more",
+  "about", "how", "guide", "review", "latest", "news", "people", "world"
+};
+
+const size_t kFillerWordCount = sizeof(kFillerWords) / sizeof(kFillerWords[0]);
+
+std::string GetGeoTargetCode(const uint64_t index) {
+  const size_t count = sizeof(kGeoTargetCodes) / sizeof(kGeoTargetCodes[0]);
+  if (index < count) {
+    return kGeoTargetCodes[index];
+  }
+
+  return "X" + std::to_string(index);
+}
+
+std::string GetSegmentName(const uint64_t segment) {
+  if (segment < kSegmentCount) {
+    return kSegments[segment];
+  }
+
+  return "Segment " + std::to_string(segment);
+}
+
+std::string GetSubsegmentName(
+    const uint64_t segment,
+    const uint64_t subsegment) {
+  if (segment < kSegmentCount && subsegment < kSubsegmentCount) {
+    return kSubsegments[segment][subsegment];
+  }
+
+  return "Topic " + std::to_string(subsegment);
+}
+
+std::string ToHex(const uint64_t value, const size_t digits) {
+  const char kHexDigits[] = "0123456789abcdef";
+
+  std::string hex(digits, '0');
+  auto remainder = value;
+  for (size_t i = digits; i > 0; i--) {
+    hex[i - 1] = kHexDigits[remainder & 0xf];
+    remainder >>= 4;
+  }
+
+  return hex;
+}
+
+TraceEventInfo CreateTraceEvent(
+    const uint64_t timestamp_in_seconds,
+    const TraceEventType type) {
+  TraceEventInfo event;
+  event.timestamp_in_seconds = timestamp_in_seconds;
+  event.type = type;
+  return event;
+}
+
+}  // namespace
+
+SyntheticCatalogOptions::SyntheticCatalogOptions() :
+    campaigns(1000),
+    creative_sets_per_campaign(1),
+    creatives_per_creative_set(1),
+    segments(kSegmentCount),
+    subsegments(kSubsegmentCount),
+    geo_targets(1),
+    geo_targets_per_campaign(1) {}
+
+SyntheticCatalogOptions::~SyntheticCatalogOptions() {}
+
+SyntheticTraceOptions::SyntheticTraceOptions() :
+    days(1),
+    page_loads_per_day(100),
+    tabs(5),
+    incognito_percentage(5),
+    search_percentage(10),
+    media_percentage(5),
+    idle_percentage(10),
+    clicked_percentage(1),
+    dismissed_percentage(5) {}
+
+SyntheticTraceOptions::~SyntheticTraceOptions() {}
+
+SyntheticDataGenerator::SyntheticDataGenerator(const uint64_t seed) :
+    engine_(seed) {
+}
+
+SyntheticDataGenerator::~SyntheticDataGenerator() = default;
+
+CatalogState SyntheticDataGenerator::GenerateCatalogState(
+    const SyntheticCatalogOptions& options) {
+  DCHECK_GT(options.segments, 0u);
+  DCHECK_GT(options.subsegments, 0u);
+  DCHECK_GT(options.geo_targets, 0u);
+
+  CatalogState catalog_state;
+  catalog_state.catalog_id = GenerateId();
+  catalog_state.version = 1;
+  catalog_state.ping = kDefaultCatalogPing * base::Time::kMillisecondsPerSecond;
+
+  for (const auto& name : {"confirmation", "payment"}) {
+    IssuerInfo issuer;
+    issuer.name = name;
+    issuer.public_key = GenerateId();
+    catalog_state.issuers.issuers.push_back(issuer);
+  }
+
+  catalog_state.campaigns.reserve(options.campaigns);
+
+  for (uint64_t i = 0; i < options.campaigns; i++) {
+    CampaignInfo campaign(GenerateId());
+    campaign.name = "Campaign " + std::to_string(i);
+    campaign.advertiser_id = GenerateId();
+    campaign.start_at = kStartAt;
+    campaign.end_at = kEndAt;
+    campaign.daily_cap = 1 + Next(5);
+    campaign.budget = 100 + Next(10000);
+
+    auto geo_target_index = Next(options.geo_targets);
+    auto geo_targets = std::min(options.geo_targets_per_campaign,
+        options.geo_targets);
+    for (uint64_t j = 0; j < geo_targets; j++) {
+      GeoTargetInfo geo_target;
+      geo_target.code = GetGeoTargetCode(
+          (geo_target_index + j) % options.geo_targets);
+      geo_target.name = geo_target.code;
+      campaign.geo_targets.push_back(geo_target);
+    }
+
+    for (uint64_t j = 0; j < options.creative_sets_per_campaign; j++) {
+      CreativeSetInfo creative_set(GenerateId());
+      creative_set.execution = "per_click";
+      creative_set.per_day = 1 + Next(5);
+      creative_set.total_max = 10 + Next(90);
+
+      auto segment_index = Next(options.segments);
+
+      SegmentInfo segment;
+      segment.code = "S" + std::to_string(segment_index);
+      segment.name = GetSegmentName(segment_index);
+      creative_set.segments.push_back(segment);
+
+      auto subsegment_index = Next(options.subsegments);
+
+      SegmentInfo subsegment;
+      subsegment.code = segment.code + "-" + std::to_string(subsegment_index);
+      subsegment.name = GetSubsegmentName(segment_index, subsegment_index);
+      creative_set.segments.push_back(subsegment);
+
+      for (uint64_t k = 0; k < options.creatives_per_creative_set; k++) {
+        CreativeInfo creative;
+        creative.creative_instance_id = GenerateId();
+        creative.type.code = "notification_all_v1";
+        creative.type.name = "notification";
+        creative.type.platform = "all";
+        creative.type.version = 1;
+        creative.payload.title = campaign.name;
+        creative.payload.body = "Creative " + std::to_string(k) + " of " +
+            campaign.name;
+        creative.payload.target_url = "https://www.example" +
+            std::to_string(i) + ".com";
+        creative_set.creatives.push_back(creative);
+      }
+
+      campaign.creative_sets.push_back(creative_set);
+    }
+
+    catalog_state.campaigns.push_back(campaign);
+  }
+
+  return catalog_state;
+}
+
+std::string SyntheticDataGenerator::GenerateCatalogJson(
+    const SyntheticCatalogOptions& options) {
+  std::string json;
+  SaveToJson(GenerateCatalogState(options), &json);
+  return json;
+}
+
+std::vector<TraceEventInfo> SyntheticDataGenerator::GenerateTrace(
+    const SyntheticTraceOptions& options) {
+  std::vector<TraceEventInfo> trace;
+
+  const uint64_t tabs = std::max<uint64_t>(options.tabs, 1);
+
+  for (uint64_t day = 0; day < options.days; day++) {
+    // Sessions start between 8am and 9am
+    uint64_t now = day * kSecondsPerDay + 8 * base::Time::kSecondsPerHour +
+        Next(base::Time::kSecondsPerHour);
+    trace.push_back(CreateTraceEvent(now, FOREGROUND_TRACE_EVENT));
+
+    for (uint64_t i = 0; i < options.page_loads_per_day; i++) {
+      now += 10 + Next(10 * base::Time::kSecondsPerMinute);
+
+      auto segment = Next(kSegmentCount);
+      auto subsegment = Next(kSubsegmentCount);
+
+      TraceEventInfo tab_updated =
+          CreateTraceEvent(now, TAB_UPDATED_TRACE_EVENT);
+      tab_updated.tab_id = 1 + Next(tabs);
+      tab_updated.is_active = true;
+      tab_updated.is_incognito = NextPercentage(options.incognito_percentage);
+
+      if (NextPercentage(options.search_percentage)) {
+        tab_updated.url = "https://www.google.com/search?q=" +
+            base::ToLowerASCII(GetSubsegmentName(segment, subsegment));
+        std::replace(tab_updated.url.begin(), tab_updated.url.end(), ' ', '+');
+      } else {
+        tab_updated.url = "https://www.example" + std::to_string(segment) +
+            ".com/" + std::to_string(subsegment) + "/" +
+            std::to_string(Next(1000));
+      }
+
+      trace.push_back(tab_updated);
+
+      // Pages in incognito tabs are never classified
+      if (!tab_updated.is_incognito) {
+        TraceEventInfo classify_page =
+            CreateTraceEvent(now + 1, CLASSIFY_PAGE_TRACE_EVENT);
+        classify_page.tab_id = tab_updated.tab_id;
+        classify_page.url = tab_updated.url;
+        classify_page.html = GenerateHtml(segment, subsegment);
+        trace.push_back(classify_page);
+      }
+
+      now++;
+
+      if (NextPercentage(options.media_percentage)) {
+        TraceEventInfo media_playing =
+            CreateTraceEvent(now, MEDIA_PLAYING_TRACE_EVENT);
+        media_playing.tab_id = tab_updated.tab_id;
+        trace.push_back(media_playing);
+
+        now += 30 + Next(10 * base::Time::kSecondsPerMinute);
+
+        TraceEventInfo media_stopped =
+            CreateTraceEvent(now, MEDIA_STOPPED_TRACE_EVENT);
+        media_stopped.tab_id = tab_updated.tab_id;
+        trace.push_back(media_stopped);
+      }
+
+      auto percentage = Next(100);
+      if (percentage < options.clicked_percentage) {
+        TraceEventInfo notification_result =
+            CreateTraceEvent(now, NOTIFICATION_RESULT_TRACE_EVENT);
+        notification_result.result_type = CLICKED;
+        trace.push_back(notification_result);
+      } else if (percentage < options.clicked_percentage +
+          options.dismissed_percentage) {
+        TraceEventInfo notification_result =
+            CreateTraceEvent(now, NOTIFICATION_RESULT_TRACE_EVENT);
+        notification_result.result_type = DISMISSED;
+        trace.push_back(notification_result);
+      }
+
+      if (NextPercentage(options.idle_percentage)) {
+        now += kIdleThresholdInSeconds;
+        trace.push_back(CreateTraceEvent(now, IDLE_TRACE_EVENT));
+
+        now += base::Time::kSecondsPerMinute +
+            Next(30 * base::Time::kSecondsPerMinute);
+        trace.push_back(CreateTraceEvent(now, UNIDLE_TRACE_EVENT));
+      }
+    }
+
+    now += base::Time::kSecondsPerMinute;
+    for (uint64_t tab_id = 1; tab_id <= tabs; tab_id++) {
+      TraceEventInfo tab_closed =
+          CreateTraceEvent(now, TAB_CLOSED_TRACE_EVENT);
+      tab_closed.tab_id = tab_id;
+      trace.push_back(tab_closed);
+    }
+
+    trace.push_back(CreateTraceEvent(now, BACKGROUND_TRACE_EVENT));
+  }
+
+  return trace;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint64_t SyntheticDataGenerator::Next(const uint64_t range) {
+  DCHECK_GT(range, 0u);
+
+  // Unlike the standard distributions, the output of the engine is fully
+  // specified, so results are the same for every standard library. Values
+  // below 2^64 % |range| are rejected so that every result is equally likely
+  const uint64_t threshold =
+      (std::numeric_limits<uint64_t>::max() - range + 1) % range;
+
+  uint64_t value;
+  do {
+    value = engine_();
+  } while (value < threshold);
+
+  return value % range;
+}
+
+bool SyntheticDataGenerator::NextPercentage(const uint64_t percentage) {
+  return Next(100) < percentage;
+}
+
+std::string SyntheticDataGenerator::GenerateId() {
+  auto high = engine_();
+  auto low = engine_();
+
+  return ToHex(high >> 32, 8) + "-" + ToHex((high >> 16) & 0xffff, 4) + "-4" +
+      ToHex(high & 0xfff, 3) + "-" + ToHex((low >> 48) & 0xffff, 4) + "-" +
+      ToHex(low, 12);
+}
+
+std::string SyntheticDataGenerator::GenerateHtml(
+    const uint64_t segment,
+    const uint64_t subsegment) {
+  auto segment_name = GetSegmentName(segment);
+  auto subsegment_name = GetSubsegmentName(segment, subsegment);
+
+  std::vector<std::string> topic_words = base::SplitString(
+      base::ToLowerASCII(segment_name + " " + subsegment_name), " ",
+      base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+
+  std::string html = "<html><head><title>" + subsegment_name + " - " +
+      segment_name + "</title></head><body><p>";
+
+  auto words = 50 + Next(150);
+  for (uint64_t i = 0; i < words; i++) {
+    if (i > 0) {
+      html += " ";
+    }
+
+    if (NextPercentage(30)) {
+      html += topic_words.at(Next(topic_words.size()));
+    } else {
+      html += kFillerWords[Next(kFillerWordCount)];
+    }
+  }
+
+  html += "</p></body></html>";
+
+  return html;
+}
+
+}  // namespace ads
@@ -0,0 +1,95 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_SYNTHETIC_DATA_GENERATOR_H_
+#define BAT_ADS_INTERNAL_SYNTHETIC_DATA_GENERATOR_H_
+
+#include <stdint.h>
+#include <string>
+#include <random>
+#include <vector>
+
+#include "bat/ads/internal/catalog_state.h"
+#include "bat/ads/internal/trace_event_info.h"
+
+namespace ads {
+
+struct SyntheticCatalogOptions {
+  SyntheticCatalogOptions();
+  ~SyntheticCatalogOptions();
+
+  uint64_t campaigns;
+  uint64_t creative_sets_per_campaign;
+  uint64_t creatives_per_creative_set;
+
+  // Number of distinct top-level segments, each with |subsegments| children.
+  // Every creative set targets one child segment, so both must be non-zero.
+  // Segments are named after the page topics used by |GenerateTrace| where
+  // possible
+  uint64_t segments;
+  uint64_t subsegments;
+
+  // Number of distinct geo target codes, of which each campaign targets
+  // |geo_targets_per_campaign|. Must be non-zero
+  uint64_t geo_targets;
+  uint64_t geo_targets_per_campaign;
+};
+
+struct SyntheticTraceOptions {
+  SyntheticTraceOptions();
+  ~SyntheticTraceOptions();
+
+  uint64_t days;
+  uint64_t page_loads_per_day;
+  uint64_t tabs;
+
+  // Percentages of page loads which are incognito, search engine result pages
+  // or play media, and of page loads followed by the user going idle
+  uint64_t incognito_percentage;
+  uint64_t search_percentage;
+  uint64_t media_percentage;
+  uint64_t idle_percentage;
+
+  // Percentages of page loads followed by a notification being clicked or
+  // dismissed, the remainder of notifications time out
+  uint64_t clicked_percentage;
+  uint64_t dismissed_percentage;
+};
+
+// Generates catalogs and browsing traces for scale testing. Output depends
+// only on the seed and the options, and is the same on every platform, so
+// that benchmarks and tests are reproducible
+class SyntheticDataGenerator {
+ public:
+  explicit SyntheticDataGenerator(const uint64_t seed);
+  ~SyntheticDataGenerator();
+
+  // Returns a catalog which is valid against the catalog schema. Campaigns
+  // are in flight from 2019 until 2099
+  CatalogState GenerateCatalogState(const SyntheticCatalogOptions& options);
+  std::string GenerateCatalogJson(const SyntheticCatalogOptions& options);
+
+  // Returns a trace of browsing sessions, one per day, ordered by timestamp.
+  // Each session starts with the browser entering the foreground and ends
+  // with it entering the background
+  std::vector<TraceEventInfo> GenerateTrace(
+      const SyntheticTraceOptions& options);
+
+ private:
+  // Returns a uniformly distributed number in the range [0, |range|).
+  // |range| must be non-zero
+  uint64_t Next(const uint64_t range);
+
+  bool NextPercentage(const uint64_t percentage);
+
+  std::string GenerateId();
+  std::string GenerateHtml(const uint64_t segment, const uint64_t subsegment);
+
+  std::mt19937_64 engine_;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_SYNTHETIC_DATA_GENERATOR_H_
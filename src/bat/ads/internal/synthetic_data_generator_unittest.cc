@@ -0,0 +1,206 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "bat/ads/ads.h"
+
+#include "bat/ads/internal/catalog_state.h"
+#include "bat/ads/internal/synthetic_data_generator.h"
+#include "bat/ads/internal/test_data_helper.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class SyntheticDataGeneratorTest : public ::testing::Test {
+ protected:
+  SyntheticDataGeneratorTest() {
+    // You can do set-up work for each test here
+  }
+
+  ~SyntheticDataGeneratorTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  SyntheticCatalogOptions GetCatalogOptions() {
+    SyntheticCatalogOptions options;
+    options.campaigns = 50;
+    options.creative_sets_per_campaign = 2;
+    options.creatives_per_creative_set = 3;
+    options.geo_targets = 4;
+    options.geo_targets_per_campaign = 2;
+    return options;
+  }
+
+  SyntheticTraceOptions GetTraceOptions() {
+    SyntheticTraceOptions options;
+    options.days = 3;
+    options.page_loads_per_day = 50;
+    options.incognito_percentage = 20;
+    return options;
+  }
+};
+
+TEST_F(SyntheticDataGeneratorTest, CatalogIsValidAgainstSchema) {
+  // Arrange
+  SyntheticDataGenerator generator(1);
+  auto json = generator.GenerateCatalogJson(GetCatalogOptions());
+  auto json_schema = helper::TestData::LoadResource(_catalog_schema_name);
+
+  // Act
+  CatalogState catalog_state;
+  auto result = catalog_state.FromJson(json, json_schema);
+
+  // Assert
+  EXPECT_EQ(SUCCESS, result);
+}
+
+TEST_F(SyntheticDataGeneratorTest, CatalogHasRequestedShape) {
+  // Arrange
+  SyntheticDataGenerator generator(1);
+  auto options = GetCatalogOptions();
+
+  // Act
+  auto catalog_state = generator.GenerateCatalogState(options);
+
+  // Assert
+  ASSERT_EQ(options.campaigns, catalog_state.campaigns.size());
+
+  std::set<std::string> geo_target_codes;
+  for (const auto& campaign : catalog_state.campaigns) {
+    EXPECT_EQ(options.geo_targets_per_campaign, campaign.geo_targets.size());
+    for (const auto& geo_target : campaign.geo_targets) {
+      geo_target_codes.insert(geo_target.code);
+    }
+
+    ASSERT_EQ(options.creative_sets_per_campaign,
+        campaign.creative_sets.size());
+    for (const auto& creative_set : campaign.creative_sets) {
+      EXPECT_EQ(2UL, creative_set.segments.size());
+      EXPECT_EQ(options.creatives_per_creative_set,
+          creative_set.creatives.size());
+    }
+  }
+
+  EXPECT_EQ(options.geo_targets, geo_target_codes.size());
+}
+
+TEST_F(SyntheticDataGeneratorTest, SameSeedGeneratesSameCatalog) {
+  // Arrange
+  SyntheticDataGenerator generator(1);
+  SyntheticDataGenerator other_generator(1);
+
+  // Act
+  auto json = generator.GenerateCatalogJson(GetCatalogOptions());
+  auto other_json = other_generator.GenerateCatalogJson(GetCatalogOptions());
+
+  // Assert
+  EXPECT_EQ(json, other_json);
+}
+
+TEST_F(SyntheticDataGeneratorTest, DifferentSeedGeneratesDifferentCatalog) {
+  // Arrange
+  SyntheticDataGenerator generator(1);
+  SyntheticDataGenerator other_generator(2);
+
+  // Act
+  auto json = generator.GenerateCatalogJson(GetCatalogOptions());
+  auto other_json = other_generator.GenerateCatalogJson(GetCatalogOptions());
+
+  // Assert
+  EXPECT_NE(json, other_json);
+}
+
+TEST_F(SyntheticDataGeneratorTest, TraceIsOrderedByTimestamp) {
+  // Arrange
+  SyntheticDataGenerator generator(1);
+
+  // Act
+  auto trace = generator.GenerateTrace(GetTraceOptions());
+
+  // Assert
+  ASSERT_FALSE(trace.empty());
+  for (size_t i = 1; i < trace.size(); i++) {
+    EXPECT_LE(trace.at(i - 1).timestamp_in_seconds,
+        trace.at(i).timestamp_in_seconds);
+  }
+}
+
+TEST_F(SyntheticDataGeneratorTest, TraceHasSessionPerDay) {
+  // Arrange
+  SyntheticDataGenerator generator(1);
+  auto options = GetTraceOptions();
+
+  // Act
+  auto trace = generator.GenerateTrace(options);
+
+  // Assert
+  uint64_t foreground_events = 0;
+  uint64_t background_events = 0;
+  uint64_t tab_updated_events = 0;
+  for (const auto& event : trace) {
+    switch (event.type) {
+      case FOREGROUND_TRACE_EVENT: {
+        foreground_events++;
+        break;
+      }
+
+      case BACKGROUND_TRACE_EVENT: {
+        background_events++;
+        break;
+      }
+
+      case TAB_UPDATED_TRACE_EVENT: {
+        tab_updated_events++;
+        break;
+      }
+
+      default: {
+        break;
+      }
+    }
+  }
+
+  EXPECT_EQ(options.days, foreground_events);
+  EXPECT_EQ(options.days, background_events);
+  EXPECT_EQ(options.days * options.page_loads_per_day, tab_updated_events);
+}
+
+TEST_F(SyntheticDataGeneratorTest, IncognitoPagesAreNotClassified) {
+  // Arrange
+  SyntheticDataGenerator generator(1);
+
+  // Act
+  auto trace = generator.GenerateTrace(GetTraceOptions());
+
+  // Assert
+  uint64_t incognito_tab_updated_events = 0;
+  for (size_t i = 0; i < trace.size(); i++) {
+    const auto& event = trace.at(i);
+    if (event.type == TAB_UPDATED_TRACE_EVENT && event.is_incognito) {
+      incognito_tab_updated_events++;
+    }
+
+    if (event.type != CLASSIFY_PAGE_TRACE_EVENT) {
+      continue;
+    }
+
+    ASSERT_GT(i, 0UL);
+    const auto& tab_updated = trace.at(i - 1);
+    EXPECT_EQ(TAB_UPDATED_TRACE_EVENT, tab_updated.type);
+    EXPECT_FALSE(tab_updated.is_incognito);
+    EXPECT_EQ(tab_updated.url, event.url);
+    EXPECT_FALSE(event.html.empty());
+  }
+
+  EXPECT_GT(incognito_tab_updated_events, 0UL);
+}
+
+}  // namespace ads
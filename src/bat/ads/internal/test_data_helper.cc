@@ -0,0 +1,109 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/test_data_helper.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "bat/ads/ads.h"
+
+#include "bat/ads/internal/bundle_builder.h"
+#include "bat/ads/internal/catalog_state.h"
+#include "bat/ads/internal/catalog_state_writer.h"
+
+namespace helper {
+
+namespace {
+
+const char kTestDataPath[] = "brave/vendor/bat-native-ads/test/data/";
+const char kResourcesPath[] = "brave/vendor/bat-native-ads/resources/";
+
+std::string LoadFile(const std::string& path) {
+  std::ifstream ifs{path};
+  if (ifs.fail()) {
+    return "";
+  }
+
+  std::stringstream stream;
+  stream << ifs.rdbuf();
+  return stream.str();
+}
+
+const ads::CatalogState& GetCatalogState() {
+  static ads::CatalogState* catalog_state = nullptr;
+  if (!catalog_state) {
+    catalog_state = new ads::CatalogState();
+
+    auto json = TestData::Load("catalog.json");
+    auto json_schema = TestData::LoadResource(ads::_catalog_schema_name);
+    catalog_state->FromJson(json, json_schema);
+  }
+
+  return *catalog_state;
+}
+
+}  // namespace
+
+std::string TestData::Load(const std::string& name) {
+  return LoadFile(kTestDataPath + name);
+}
+
+std::string TestData::LoadResource(const std::string& name) {
+  return LoadFile(kResourcesPath + name);
+}
+
+std::vector<ads::CampaignInfo> TestData::GetCampaigns(const size_t scale) {
+  const auto& catalog_state = GetCatalogState();
+
+  std::vector<ads::CampaignInfo> campaigns;
+  campaigns.reserve(catalog_state.campaigns.size() * scale);
+
+  for (size_t i = 0; i < scale; i++) {
+    auto suffix = "-" + std::to_string(i);
+
+    for (const auto& campaign : catalog_state.campaigns) {
+      ads::CampaignInfo campaign_info(campaign);
+      campaign_info.campaign_id += suffix;
+
+      for (auto& creative_set : campaign_info.creative_sets) {
+        creative_set.creative_set_id += suffix;
+
+        for (auto& creative : creative_set.creatives) {
+          creative.creative_instance_id += suffix;
+        }
+      }
+
+      campaigns.push_back(campaign_info);
+    }
+  }
+
+  return campaigns;
+}
+
+std::string TestData::GetCatalogJson(const size_t scale) {
+  ads::CatalogState catalog_state(GetCatalogState());
+  catalog_state.campaigns = GetCampaigns(scale);
+
+  std::string json;
+  ads::SaveToJson(catalog_state, &json);
+  return json;
+}
+
+std::unique_ptr<ads::BundleState> TestData::GetBundleState(
+    const size_t scale) {
+  const auto& catalog_state = GetCatalogState();
+
+  auto bundle_state = std::make_unique<ads::BundleState>();
+  bundle_state->catalog_id = catalog_state.catalog_id;
+  bundle_state->catalog_version = catalog_state.version;
+  bundle_state->catalog_ping = catalog_state.ping;
+  bundle_state->catalog_last_updated_timestamp_in_seconds = 0;
+  ads::BundleBuilder::Build(GetCampaigns(scale), &bundle_state->categories);
+
+  return bundle_state;
+}
+
+}  // namespace helper
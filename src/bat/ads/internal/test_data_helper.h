@@ -0,0 +1,44 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_TEST_DATA_HELPER_H_
+#define BAT_ADS_INTERNAL_TEST_DATA_HELPER_H_
+
+#include <stdint.h>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "bat/ads/bundle_state.h"
+
+#include "bat/ads/internal/campaign_info.h"
+
+namespace helper {
+
+class TestData {
+ public:
+  // Returns the contents of the specified file in test/data, or an empty
+  // string if the file could not be read
+  static std::string Load(const std::string& name);
+
+  // Returns the contents of the specified file in resources, or an empty
+  // string if the file could not be read
+  static std::string LoadResource(const std::string& name);
+
+  // Returns the campaigns from test/data/catalog.json repeated |scale| times.
+  // Campaign, creative set and creative ids are suffixed for each copy so that
+  // the enlarged catalog has the shape of a real catalog of that size
+  static std::vector<ads::CampaignInfo> GetCampaigns(const size_t scale);
+
+  // Returns the catalog JSON for |GetCampaigns|
+  static std::string GetCatalogJson(const size_t scale);
+
+  // Returns the bundle state built from |GetCampaigns|
+  static std::unique_ptr<ads::BundleState> GetBundleState(const size_t scale);
+};
+
+}  // namespace helper
+
+#endif  // BAT_ADS_INTERNAL_TEST_DATA_HELPER_H_
@@ -11,6 +11,29 @@
 
 namespace helper {
 
+namespace {
+
+// Digits are marked as '0', all other characters must match exactly
+const char kUTCStringFormat[] = "0000-00-00T00:00:00";
+
+bool IsDigit(const char c) {
+  return c >= '0' && c <= '9';
+}
+
+int ParseDigits(
+    const std::string& value,
+    const size_t position,
+    const size_t count) {
+  int digits = 0;
+  for (size_t i = position; i < position + count; i++) {
+    digits = digits * 10 + (value.at(i) - '0');
+  }
+
+  return digits;
+}
+
+}  // namespace
+
 std::string Time::TimeStamp() {
   time_t rawtime;
   std::time(&rawtime);
@@ -26,4 +49,68 @@ uint64_t Time::NowInSeconds() {
   return static_cast<uint64_t>((now - base::Time()).InSeconds());
 }
 
+bool Time::FromUTCString(
+    const std::string& timestamp,
+    uint64_t* timestamp_in_seconds) {
+  const size_t length = sizeof(kUTCStringFormat) - 1;
+  if (timestamp.size() <= length) {
+    return false;
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    if (kUTCStringFormat[i] == '0') {
+      if (!IsDigit(timestamp.at(i))) {
+        return false;
+      }
+
+      continue;
+    }
+
+    if (timestamp.at(i) != kUTCStringFormat[i]) {
+      return false;
+    }
+  }
+
+  // Optional fractional seconds, which must be followed by "Z" as offsets
+  // other than UTC are not supported
+  auto position = length;
+  if (timestamp.at(position) == '.') {
+    position++;
+
+    auto fraction_position = position;
+    while (position < timestamp.size() && IsDigit(timestamp.at(position))) {
+      position++;
+    }
+
+    if (position == fraction_position) {
+      return false;
+    }
+  }
+
+  if (position + 1 != timestamp.size() || timestamp.at(position) != 'Z') {
+    return false;
+  }
+
+  base::Time::Exploded exploded = {};
+  exploded.year = ParseDigits(timestamp, 0, 4);
+  exploded.month = ParseDigits(timestamp, 5, 2);
+  exploded.day_of_month = ParseDigits(timestamp, 8, 2);
+  exploded.hour = ParseDigits(timestamp, 11, 2);
+  exploded.minute = ParseDigits(timestamp, 14, 2);
+  exploded.second = ParseDigits(timestamp, 17, 2);
+
+  base::Time time;
+  if (!base::Time::FromUTCExploded(exploded, &time)) {
+    return false;
+  }
+
+  auto seconds = (time - base::Time()).InSeconds();
+  if (seconds < 0) {
+    return false;
+  }
+
+  *timestamp_in_seconds = static_cast<uint64_t>(seconds);
+  return true;
+}
+
 }  // namespace helper
@@ -16,6 +16,14 @@ class Time {
   static std::string TimeStamp();
 
   static uint64_t NowInSeconds();
+
+  // Parses an ISO 8601 UTC timestamp, i.e. "2019-06-01T00:00:00.000Z", into
+  // seconds with the same epoch as |NowInSeconds|. Fractional seconds are
+  // optional and ignored. Returns false for timestamps with an offset other
+  // than "Z" or with trailing characters
+  static bool FromUTCString(
+      const std::string& timestamp,
+      uint64_t* timestamp_in_seconds);
 };
 
 }  // namespace helper
@@ -0,0 +1,94 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <string>
+
+#include "bat/ads/internal/time_helper.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+TEST(TimeHelperTest, FromUTCString) {
+  // Arrange
+  uint64_t start_timestamp_in_seconds = 0;
+  ASSERT_TRUE(helper::Time::FromUTCString("2019-06-01T00:00:00Z",
+      &start_timestamp_in_seconds));
+
+  uint64_t timestamp_in_seconds = 0;
+
+  // Act
+  auto result = helper::Time::FromUTCString("2019-06-02T01:02:03Z",
+      &timestamp_in_seconds);
+
+  // Assert
+  EXPECT_TRUE(result);
+  EXPECT_EQ(start_timestamp_in_seconds + 90123, timestamp_in_seconds);
+}
+
+TEST(TimeHelperTest, FromUTCString_IgnoresFractionalSeconds) {
+  // Arrange
+  uint64_t expected_timestamp_in_seconds = 0;
+  ASSERT_TRUE(helper::Time::FromUTCString("2019-06-01T00:00:00Z",
+      &expected_timestamp_in_seconds));
+
+  uint64_t timestamp_in_seconds = 0;
+
+  // Act
+  auto result = helper::Time::FromUTCString("2019-06-01T00:00:00.999Z",
+      &timestamp_in_seconds);
+
+  // Assert
+  EXPECT_TRUE(result);
+  EXPECT_EQ(expected_timestamp_in_seconds, timestamp_in_seconds);
+}
+
+TEST(TimeHelperTest, FromUTCString_RejectsOffsets) {
+  for (const std::string timestamp : {
+      "2019-06-01T00:00:00+01:00",
+      "2019-06-01T00:00:00.000-05:00",
+      "2019-06-01T00:00:00+00:00",
+      "2019-06-01T00:00:00"}) {
+    // Arrange
+    uint64_t timestamp_in_seconds = 0;
+
+    // Act
+    auto result = helper::Time::FromUTCString(timestamp,
+        &timestamp_in_seconds);
+
+    // Assert
+    EXPECT_FALSE(result) << timestamp;
+    EXPECT_EQ(0UL, timestamp_in_seconds) << timestamp;
+  }
+}
+
+TEST(TimeHelperTest, FromUTCString_RejectsGarbage) {
+  for (const std::string timestamp : {
+      "",
+      "2019-06-01T00:00:00Zgarbage",
+      "2019-06-01T00:00:00.Z",
+      "2019-06-01T00:00:00.000",
+      "2019-06-01T00:00:00.0a0Z",
+      "2019-06-01 00:00:00Z",
+      "2019-6-01T00:00:00Z",
+      " 2019-06-01T00:00:00Z",
+      "+2019-06-01T00:00:00Z",
+      "2019-06-01T-1:00:00Z",
+      "2019-13-01T00:00:00Z"}) {
+    // Arrange
+    uint64_t timestamp_in_seconds = 0;
+
+    // Act
+    auto result = helper::Time::FromUTCString(timestamp,
+        &timestamp_in_seconds);
+
+    // Assert
+    EXPECT_FALSE(result) << timestamp;
+    EXPECT_EQ(0UL, timestamp_in_seconds) << timestamp;
+  }
+}
+
+}  // namespace ads
@@ -0,0 +1,219 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/trace_event_info.h"
+
+#include <map>
+
+#include "bat/ads/internal/json_helper.h"
+
+namespace ads {
+
+namespace {
+
+const std::map<TraceEventType, std::string> kTraceEventTypeNames = {
+  {TAB_UPDATED_TRACE_EVENT, "TabUpdated"},
+  {CLASSIFY_PAGE_TRACE_EVENT, "ClassifyPage"},
+  {TAB_CLOSED_TRACE_EVENT, "TabClosed"},
+  {MEDIA_PLAYING_TRACE_EVENT, "OnMediaPlaying"},
+  {MEDIA_STOPPED_TRACE_EVENT, "OnMediaStopped"},
+  {IDLE_TRACE_EVENT, "OnIdle"},
+  {UNIDLE_TRACE_EVENT, "OnUnIdle"},
+  {FOREGROUND_TRACE_EVENT, "OnForeground"},
+  {BACKGROUND_TRACE_EVENT, "OnBackground"},
+  {NOTIFICATION_RESULT_TRACE_EVENT, "NotificationResult"},
+  {TIMER_TRACE_EVENT, "OnTimer"}
+};
+
+const std::map<NotificationResultInfoResultType, std::string>
+    kResultTypeNames = {
+  {CLICKED, "clicked"},
+  {DISMISSED, "dismissed"},
+  {TIMEOUT, "timeout"}
+};
+
+}  // namespace
+
+TraceEventInfo::TraceEventInfo() :
+    timestamp_in_seconds(0),
+    type(TAB_UPDATED_TRACE_EVENT),
+    tab_id(-1),
+    url(""),
+    html(""),
+    is_active(false),
+    is_incognito(false),
+    result_type(TIMEOUT) {}
+
+TraceEventInfo::TraceEventInfo(const TraceEventInfo& info) :
+    timestamp_in_seconds(info.timestamp_in_seconds),
+    type(info.type),
+    tab_id(info.tab_id),
+    url(info.url),
+    html(info.html),
+    is_active(info.is_active),
+    is_incognito(info.is_incognito),
+    result_type(info.result_type) {}
+
+TraceEventInfo::TraceEventInfo(TraceEventInfo&& info) noexcept = default;
+
+TraceEventInfo& TraceEventInfo::operator=(
+    const TraceEventInfo& info) = default;
+
+TraceEventInfo& TraceEventInfo::operator=(
+    TraceEventInfo&& info) noexcept = default;
+
+TraceEventInfo::~TraceEventInfo() {}
+
+const std::string TraceEventInfo::ToJson() const {
+  std::string json;
+  SaveToJson(*this, &json);
+  return json;
+}
+
+Result TraceEventInfo::FromJson(
+    const std::string& json,
+    std::string* error_description) {
+  rapidjson::Document document;
+  document.Parse(json.c_str());
+
+  if (document.HasParseError()) {
+    if (error_description != nullptr) {
+      *error_description = helper::JSON::GetLastError(&document);
+    }
+
+    return FAILED;
+  }
+
+  if (!document.IsObject() || !document.HasMember("type")) {
+    if (error_description != nullptr) {
+      *error_description = "Trace event is missing a type";
+    }
+
+    return FAILED;
+  }
+
+  bool has_type = false;
+  std::string type_name = document["type"].GetString();
+  for (const auto& name : kTraceEventTypeNames) {
+    if (name.second == type_name) {
+      type = name.first;
+      has_type = true;
+      break;
+    }
+  }
+
+  if (!has_type) {
+    if (error_description != nullptr) {
+      *error_description = "Unknown trace event type: " + type_name;
+    }
+
+    return FAILED;
+  }
+
+  if (document.HasMember("timestamp")) {
+    timestamp_in_seconds = document["timestamp"].GetUint64();
+  }
+
+  if (document.HasMember("tab_id")) {
+    tab_id = document["tab_id"].GetInt();
+  }
+
+  if (document.HasMember("url")) {
+    url = document["url"].GetString();
+  }
+
+  if (document.HasMember("html")) {
+    html = document["html"].GetString();
+  }
+
+  if (document.HasMember("is_active")) {
+    is_active = document["is_active"].GetBool();
+  }
+
+  if (document.HasMember("is_incognito")) {
+    is_incognito = document["is_incognito"].GetBool();
+  }
+
+  if (document.HasMember("result")) {
+    std::string result_name = document["result"].GetString();
+    for (const auto& name : kResultTypeNames) {
+      if (name.second == result_name) {
+        result_type = name.first;
+        break;
+      }
+    }
+  }
+
+  return SUCCESS;
+}
+
+void SaveToJson(JsonWriter* writer, const TraceEventInfo& info) {
+  writer->StartObject();
+
+  writer->String("timestamp");
+  writer->Uint64(info.timestamp_in_seconds);
+
+  writer->String("type");
+  writer->String(kTraceEventTypeNames.at(info.type).c_str());
+
+  switch (info.type) {
+    case TAB_UPDATED_TRACE_EVENT: {
+      writer->String("tab_id");
+      writer->Int(info.tab_id);
+
+      writer->String("url");
+      writer->String(info.url.c_str());
+
+      writer->String("is_active");
+      writer->Bool(info.is_active);
+
+      writer->String("is_incognito");
+      writer->Bool(info.is_incognito);
+
+      break;
+    }
+
+    case CLASSIFY_PAGE_TRACE_EVENT: {
+      writer->String("tab_id");
+      writer->Int(info.tab_id);
+
+      writer->String("url");
+      writer->String(info.url.c_str());
+
+      writer->String("html");
+      writer->String(info.html.c_str());
+
+      break;
+    }
+
+    case TAB_CLOSED_TRACE_EVENT:
+    case MEDIA_PLAYING_TRACE_EVENT:
+    case MEDIA_STOPPED_TRACE_EVENT: {
+      writer->String("tab_id");
+      writer->Int(info.tab_id);
+
+      break;
+    }
+
+    case NOTIFICATION_RESULT_TRACE_EVENT: {
+      writer->String("result");
+      writer->String(kResultTypeNames.at(info.result_type).c_str());
+
+      break;
+    }
+
+    case IDLE_TRACE_EVENT:
+    case UNIDLE_TRACE_EVENT:
+    case FOREGROUND_TRACE_EVENT:
+    case BACKGROUND_TRACE_EVENT:
+    case TIMER_TRACE_EVENT: {
+      break;
+    }
+  }
+
+  writer->EndObject();
+}
+
+}  // namespace ads
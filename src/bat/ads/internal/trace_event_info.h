@@ -0,0 +1,61 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_TRACE_EVENT_INFO_H_
+#define BAT_ADS_INTERNAL_TRACE_EVENT_INFO_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "bat/ads/notification_result_type.h"
+#include "bat/ads/result.h"
+
+namespace ads {
+
+enum TraceEventType {
+  TAB_UPDATED_TRACE_EVENT,
+  CLASSIFY_PAGE_TRACE_EVENT,
+  TAB_CLOSED_TRACE_EVENT,
+  MEDIA_PLAYING_TRACE_EVENT,
+  MEDIA_STOPPED_TRACE_EVENT,
+  IDLE_TRACE_EVENT,
+  UNIDLE_TRACE_EVENT,
+  FOREGROUND_TRACE_EVENT,
+  BACKGROUND_TRACE_EVENT,
+  NOTIFICATION_RESULT_TRACE_EVENT,
+  TIMER_TRACE_EVENT
+};
+
+// A call into |Ads| recorded as part of a browsing session. |url| and |html|
+// are only used by tab and page events, and |result_type| by notification
+// result events which apply to the most recently shown notification. Timer
+// events are recorded for reference only, as timer ids differ between runs
+struct TraceEventInfo {
+  TraceEventInfo();
+  explicit TraceEventInfo(const TraceEventInfo& info);
+  TraceEventInfo(TraceEventInfo&& info) noexcept;
+  TraceEventInfo& operator=(const TraceEventInfo& info);
+  TraceEventInfo& operator=(TraceEventInfo&& info) noexcept;
+  ~TraceEventInfo();
+
+  const std::string ToJson() const;
+  Result FromJson(
+      const std::string& json,
+      std::string* error_description = nullptr);
+
+  // Seconds since the start of the trace
+  uint64_t timestamp_in_seconds;
+  TraceEventType type;
+  int32_t tab_id;
+  std::string url;
+  std::string html;
+  bool is_active;
+  bool is_incognito;
+  NotificationResultInfoResultType result_type;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_TRACE_EVENT_INFO_H_
@@ -0,0 +1,193 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/trace_log.h"
+
+#include "bat/ads/internal/json_helper.h"
+
+#include "base/no_destructor.h"
+#include "base/process/process_handle.h"
+#include "base/threading/platform_thread.h"
+
+namespace ads {
+
+TraceLogEntry::TraceLogEntry() :
+    name(""),
+    phase(TRACE_EVENT_PHASE_COMPLETE),
+    timestamp_in_microseconds(0),
+    duration_in_microseconds(0),
+    id(0),
+    thread_id(0) {}
+
+TraceLogEntry::TraceLogEntry(const TraceLogEntry& entry) = default;
+
+TraceLogEntry::~TraceLogEntry() = default;
+
+///////////////////////////////////////////////////////////////////////////////
+
+const size_t TraceLog::kDefaultCapacity;
+
+TraceLog::TraceLog(const size_t capacity) :
+    capacity_(capacity),
+    origin_(base::TimeTicks::Now()),
+    next_entry_(0) {
+  entries_.reserve(capacity);
+}
+
+TraceLog::~TraceLog() = default;
+
+TraceLog* TraceLog::GetInstance() {
+  static base::NoDestructor<TraceLog> instance(kDefaultCapacity);
+  return instance.get();
+}
+
+void TraceLog::AddCompleteEvent(
+    const char* name,
+    const base::TimeTicks& start,
+    const base::TimeTicks& end) {
+  TraceLogEntry entry;
+  entry.name = name;
+  entry.phase = TRACE_EVENT_PHASE_COMPLETE;
+  entry.timestamp_in_microseconds = GetTimestampInMicroseconds(start);
+  entry.duration_in_microseconds = (end - start).InMicroseconds();
+
+  AddEntry(entry);
+}
+
+void TraceLog::AddAsyncEvent(
+    const TraceEventPhase phase,
+    const char* name,
+    const void* id) {
+  TraceLogEntry entry;
+  entry.name = name;
+  entry.phase = phase;
+  entry.timestamp_in_microseconds =
+      GetTimestampInMicroseconds(base::TimeTicks::Now());
+  entry.id = reinterpret_cast<uintptr_t>(id);
+
+  AddEntry(entry);
+}
+
+std::vector<TraceLogEntry> TraceLog::GetEntries() const {
+  base::AutoLock auto_lock(lock_);
+
+  if (entries_.size() < capacity_) {
+    return entries_;
+  }
+
+  std::vector<TraceLogEntry> entries;
+  entries.reserve(entries_.size());
+  entries.insert(entries.end(), entries_.begin() + next_entry_,
+      entries_.end());
+  entries.insert(entries.end(), entries_.begin(),
+      entries_.begin() + next_entry_);
+
+  return entries;
+}
+
+const std::string TraceLog::ToJson() const {
+  std::string json;
+  SaveToJson(*this, &json);
+  return json;
+}
+
+void TraceLog::Clear() {
+  base::AutoLock auto_lock(lock_);
+
+  entries_.clear();
+  next_entry_ = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void TraceLog::AddEntry(const TraceLogEntry& entry) {
+  auto thread_id = base::PlatformThread::CurrentId();
+
+  base::AutoLock auto_lock(lock_);
+
+  if (capacity_ == 0) {
+    return;
+  }
+
+  if (entries_.size() < capacity_) {
+    entries_.push_back(entry);
+    entries_.back().thread_id = thread_id;
+    return;
+  }
+
+  entries_[next_entry_] = entry;
+  entries_[next_entry_].thread_id = thread_id;
+  next_entry_ = (next_entry_ + 1) % entries_.size();
+}
+
+int64_t TraceLog::GetTimestampInMicroseconds(
+    const base::TimeTicks& time_ticks) const {
+  return (time_ticks - origin_).InMicroseconds();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ScopedTraceEvent::ScopedTraceEvent(const char* name) :
+    ScopedTraceEvent(TraceLog::GetInstance(), name) {}
+
+ScopedTraceEvent::ScopedTraceEvent(TraceLog* trace_log, const char* name) :
+    trace_log_(trace_log),
+    name_(name),
+    start_(base::TimeTicks::Now()) {}
+
+ScopedTraceEvent::~ScopedTraceEvent() {
+  trace_log_->AddCompleteEvent(name_, start_, base::TimeTicks::Now());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SaveToJson(JsonWriter* writer, const TraceLog& trace_log) {
+  auto process_id = base::GetCurrentProcId();
+
+  writer->StartObject();
+
+  writer->String("traceEvents");
+  writer->StartArray();
+  for (const auto& entry : trace_log.GetEntries()) {
+    writer->StartObject();
+
+    writer->String("name");
+    writer->String(entry.name);
+
+    writer->String("cat");
+    writer->String("bat_ads");
+
+    const char phase[] = { static_cast<char>(entry.phase), '\0' };
+    writer->String("ph");
+    writer->String(phase);
+
+    writer->String("ts");
+    writer->Int64(entry.timestamp_in_microseconds);
+
+    if (entry.phase == TRACE_EVENT_PHASE_COMPLETE) {
+      writer->String("dur");
+      writer->Int64(entry.duration_in_microseconds);
+    } else {
+      writer->String("id");
+      writer->Uint64(entry.id);
+    }
+
+    writer->String("pid");
+    writer->Int64(process_id);
+
+    writer->String("tid");
+    writer->Int64(entry.thread_id);
+
+    writer->EndObject();
+  }
+  writer->EndArray();
+
+  writer->String("displayTimeUnit");
+  writer->String("ms");
+
+  writer->EndObject();
+}
+
+}  // namespace ads
@@ -0,0 +1,123 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_TRACE_LOG_H_
+#define BAT_ADS_INTERNAL_TRACE_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+
+// Trace events compile to nothing unless the library is built with
+// |bat_ads_enable_tracing|. |name| must be a string literal. Async spans are
+// matched by |name| and |id|, which should be a pointer to the object that
+// receives the callback, i.e. |this|
+#if defined(BAT_ADS_ENABLE_TRACING)
+#define ADS_TRACE_EVENT(name) \
+    ads::ScopedTraceEvent scoped_trace_event(name)
+#define ADS_TRACE_ASYNC_BEGIN(name, id) \
+    ads::TraceLog::GetInstance()->AddAsyncEvent( \
+        ads::TRACE_EVENT_PHASE_ASYNC_BEGIN, name, id)
+#define ADS_TRACE_ASYNC_END(name, id) \
+    ads::TraceLog::GetInstance()->AddAsyncEvent( \
+        ads::TRACE_EVENT_PHASE_ASYNC_END, name, id)
+#else
+#define ADS_TRACE_EVENT(name)
+#define ADS_TRACE_ASYNC_BEGIN(name, id)
+#define ADS_TRACE_ASYNC_END(name, id)
+#endif
+
+namespace ads {
+
+// Phases as defined by the Chrome Trace Event format
+enum TraceEventPhase {
+  TRACE_EVENT_PHASE_COMPLETE = 'X',
+  TRACE_EVENT_PHASE_ASYNC_BEGIN = 'b',
+  TRACE_EVENT_PHASE_ASYNC_END = 'e'
+};
+
+struct TraceLogEntry {
+  TraceLogEntry();
+  TraceLogEntry(const TraceLogEntry& entry);
+  ~TraceLogEntry();
+
+  const char* name;
+  TraceEventPhase phase;
+  int64_t timestamp_in_microseconds;
+  int64_t duration_in_microseconds;
+  uint64_t id;
+  int64_t thread_id;
+};
+
+// Records trace events into a fixed size ring buffer, overwriting the oldest
+// events once full, so that tracing can be left on and dumped on demand as
+// Chrome Trace Event JSON for chrome://tracing or Perfetto
+class TraceLog {
+ public:
+  explicit TraceLog(const size_t capacity);
+  ~TraceLog();
+
+  static TraceLog* GetInstance();
+
+  void AddCompleteEvent(
+      const char* name,
+      const base::TimeTicks& start,
+      const base::TimeTicks& end);
+
+  void AddAsyncEvent(
+      const TraceEventPhase phase,
+      const char* name,
+      const void* id);
+
+  // Returns the recorded events, oldest first
+  std::vector<TraceLogEntry> GetEntries() const;
+
+  const std::string ToJson() const;
+
+  void Clear();
+
+  static const size_t kDefaultCapacity = 10000;
+
+ private:
+  void AddEntry(const TraceLogEntry& entry);
+
+  int64_t GetTimestampInMicroseconds(const base::TimeTicks& time_ticks) const;
+
+  const size_t capacity_;
+  const base::TimeTicks origin_;
+
+  mutable base::Lock lock_;
+  std::vector<TraceLogEntry> entries_;  // GUARDED_BY(lock_)
+  size_t next_entry_;  // GUARDED_BY(lock_)
+
+  // Not copyable, not assignable
+  TraceLog(const TraceLog&) = delete;
+  TraceLog& operator=(const TraceLog&) = delete;
+};
+
+// Records the lifetime of the scope as a complete event
+class ScopedTraceEvent {
+ public:
+  explicit ScopedTraceEvent(const char* name);
+  ScopedTraceEvent(TraceLog* trace_log, const char* name);
+  ~ScopedTraceEvent();
+
+ private:
+  TraceLog* trace_log_;  // NOT OWNED
+  const char* name_;
+  base::TimeTicks start_;
+
+  // Not copyable, not assignable
+  ScopedTraceEvent(const ScopedTraceEvent&) = delete;
+  ScopedTraceEvent& operator=(const ScopedTraceEvent&) = delete;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_TRACE_LOG_H_
@@ -0,0 +1,111 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "bat/ads/internal/trace_log.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class TraceLogTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<TraceLog> trace_log_;
+
+  TraceLogTest() :
+      trace_log_(std::make_unique<TraceLog>(3)) {
+    // You can do set-up work for each test here
+  }
+
+  ~TraceLogTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+};
+
+TEST_F(TraceLogTest, AddCompleteEvent) {
+  // Arrange
+  auto start = base::TimeTicks::Now();
+  auto end = start + base::TimeDelta::FromMilliseconds(5);
+
+  // Act
+  trace_log_->AddCompleteEvent("ClassifyPage", start, end);
+
+  // Assert
+  auto entries = trace_log_->GetEntries();
+  ASSERT_EQ(1UL, entries.size());
+  EXPECT_EQ(std::string("ClassifyPage"), entries.front().name);
+  EXPECT_EQ(TRACE_EVENT_PHASE_COMPLETE, entries.front().phase);
+  EXPECT_EQ(5000, entries.front().duration_in_microseconds);
+}
+
+TEST_F(TraceLogTest, ScopedTraceEvent) {
+  // Arrange
+
+  // Act
+  {
+    ScopedTraceEvent scoped_trace_event(trace_log_.get(), "ShowAd");
+  }
+
+  // Assert
+  auto entries = trace_log_->GetEntries();
+  ASSERT_EQ(1UL, entries.size());
+  EXPECT_EQ(std::string("ShowAd"), entries.front().name);
+  EXPECT_EQ(TRACE_EVENT_PHASE_COMPLETE, entries.front().phase);
+  EXPECT_LE(0, entries.front().duration_in_microseconds);
+}
+
+TEST_F(TraceLogTest, AsyncEventsAreMatchedById) {
+  // Arrange
+  int object;
+
+  // Act
+  trace_log_->AddAsyncEvent(TRACE_EVENT_PHASE_ASYNC_BEGIN, "Load", &object);
+  trace_log_->AddAsyncEvent(TRACE_EVENT_PHASE_ASYNC_END, "Load", &object);
+
+  // Assert
+  auto entries = trace_log_->GetEntries();
+  ASSERT_EQ(2UL, entries.size());
+  EXPECT_EQ(TRACE_EVENT_PHASE_ASYNC_BEGIN, entries.at(0).phase);
+  EXPECT_EQ(TRACE_EVENT_PHASE_ASYNC_END, entries.at(1).phase);
+  EXPECT_EQ(entries.at(0).id, entries.at(1).id);
+  EXPECT_LE(entries.at(0).timestamp_in_microseconds,
+      entries.at(1).timestamp_in_microseconds);
+}
+
+TEST_F(TraceLogTest, OverwritesOldestEventsWhenFull) {
+  // Arrange
+  const char* names[] = { "1", "2", "3", "4", "5" };
+
+  // Act
+  for (const auto* name : names) {
+    ScopedTraceEvent scoped_trace_event(trace_log_.get(), name);
+  }
+
+  // Assert
+  auto entries = trace_log_->GetEntries();
+  ASSERT_EQ(3UL, entries.size());
+  EXPECT_EQ(std::string("3"), entries.at(0).name);
+  EXPECT_EQ(std::string("4"), entries.at(1).name);
+  EXPECT_EQ(std::string("5"), entries.at(2).name);
+}
+
+TEST_F(TraceLogTest, Clear) {
+  // Arrange
+  {
+    ScopedTraceEvent scoped_trace_event(trace_log_.get(), "SaveState");
+  }
+
+  // Act
+  trace_log_->Clear();
+
+  // Assert
+  EXPECT_TRUE(trace_log_->GetEntries().empty());
+}
+
+}  // namespace ads
@@ -0,0 +1,76 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bat/ads/internal/synthetic_data_generator.h"
+#include "bat/ads/internal/test_data_helper.h"
+#include "bat/ads/internal/trace_replayer.h"
+
+namespace {
+
+bool ReadFile(const std::string& path, std::string* value) {
+  std::ifstream ifs{path};
+  if (ifs.fail()) {
+    return false;
+  }
+
+  std::stringstream stream;
+  stream << ifs.rdbuf();
+  *value = stream.str();
+  return true;
+}
+
+}  // namespace
+
+// Usage: bat_native_ads_trace_replay [trace] [catalog]
+//
+// Replays |trace|, one JSON encoded trace event per line, against |catalog|
+// and prints the report. Replays a week of synthetic browsing against
+// test/data/catalog.json if not specified
+int main(int argc, char* argv[]) {
+  std::vector<ads::TraceEventInfo> trace;
+  if (argc > 1) {
+    std::string json;
+    if (!ReadFile(argv[1], &json)) {
+      std::cerr << "Failed to read trace: " << argv[1] << std::endl;
+      return 1;
+    }
+
+    std::string error_description;
+    if (ads::TraceReplayer::ParseTrace(json, &trace, &error_description) !=
+        ads::SUCCESS) {
+      std::cerr << "Failed to parse trace: " << error_description << std::endl;
+      return 1;
+    }
+  } else {
+    ads::SyntheticTraceOptions options;
+    options.days = 7;
+
+    ads::SyntheticDataGenerator generator(1);
+    trace = generator.GenerateTrace(options);
+  }
+
+  std::string catalog_json;
+  if (argc > 2) {
+    if (!ReadFile(argv[2], &catalog_json)) {
+      std::cerr << "Failed to read catalog: " << argv[2] << std::endl;
+      return 1;
+    }
+  } else {
+    catalog_json = helper::TestData::Load("catalog.json");
+  }
+
+  ads::TraceReplayer replayer(catalog_json);
+  auto report = replayer.Replay(trace);
+
+  std::cout << report.ToString();
+
+  return 0;
+}
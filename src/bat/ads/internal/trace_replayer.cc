@@ -0,0 +1,524 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/trace_replayer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/ads_impl.h"
+#include "bat/ads/internal/test_data_helper.h"
+
+#include "base/strings/string_split.h"
+#include "base/time/time_override.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::WithArg;
+
+namespace ads {
+
+namespace {
+
+// 2019-06-01T00:00:00Z
+const double kStartTime = 1559347200;
+
+const uint64_t kAdsPerHour = 2;
+const uint64_t kAdsPerDay = 20;
+
+base::Time g_now;
+
+base::Time Now() {
+  return g_now;
+}
+
+class NullLogStream : public LogStream {
+ public:
+  NullLogStream() : stream_(nullptr) {}
+  ~NullLogStream() override = default;
+
+  std::ostream& stream() override {
+    return stream_;
+  }
+
+ private:
+  std::ostream stream_;
+};
+
+}  // namespace
+
+// Discards logs, which would otherwise dominate the measured latencies
+class ReplayAdsClient : public NiceMock<MockAdsClient> {
+ public:
+  ReplayAdsClient() = default;
+  ~ReplayAdsClient() override = default;
+
+  std::unique_ptr<LogStream> Log(
+      const char* file,
+      int line,
+      const LogLevel log_level) const override {
+    return std::make_unique<NullLogStream>();
+  }
+};
+
+TraceReplayReport::TraceReplayReport() :
+    events(0),
+    timers_fired(0),
+    ads_served(0),
+    save_calls(0),
+    save_bytes(0),
+    event_log_calls(0),
+    event_log_bytes(0),
+    catalog_requests(0) {}
+
+TraceReplayReport::~TraceReplayReport() = default;
+
+int64_t TraceReplayReport::GetPercentile(
+    const std::vector<int64_t>& latencies,
+    const double percentile) {
+  if (latencies.empty()) {
+    return 0;
+  }
+
+  // Nearest rank
+  auto rank = static_cast<size_t>(
+      std::ceil(percentile * latencies.size() / 100.0));
+  rank = std::min(std::max<size_t>(rank, 1), latencies.size());
+  return latencies.at(rank - 1);
+}
+
+std::string TraceReplayReport::ToString() const {
+  std::ostringstream stream;
+
+  stream << "Events: " << events << std::endl;
+  stream << "Timers fired: " << timers_fired << std::endl;
+  stream << "Ads served: " << ads_served << std::endl;
+  stream << "Catalog requests: " << catalog_requests << std::endl;
+  stream << "Save calls: " << save_calls << " (" << save_bytes << " bytes)"
+      << std::endl;
+  stream << "EventLog calls: " << event_log_calls << " (" << event_log_bytes
+      << " bytes)" << std::endl;
+
+  stream << std::endl << std::left << std::setw(48) << "Latency (us)"
+      << std::right << std::setw(8) << "calls" << std::setw(8) << "p50"
+      << std::setw(8) << "p90" << std::setw(8) << "p99" << std::setw(8)
+      << "max" << std::endl;
+
+  for (const auto& latency : latencies) {
+    const auto& values = latency.second;
+
+    stream << std::left << std::setw(48) << latency.first << std::right
+        << std::setw(8) << values.size()
+        << std::setw(8) << GetPercentile(values, 50)
+        << std::setw(8) << GetPercentile(values, 90)
+        << std::setw(8) << GetPercentile(values, 99)
+        << std::setw(8) << GetPercentile(values, 100) << std::endl;
+  }
+
+  return stream.str();
+}
+
+TraceReplayer::TraceReplayer(const std::string& catalog_json) :
+    mock_ads_client_(std::make_unique<ReplayAdsClient>()),
+    catalog_json_(catalog_json),
+    start_time_(base::Time::FromDoubleT(kStartTime)),
+    next_timer_id_(1),
+    next_uuid_(0),
+    is_foreground_(false),
+    last_notification_(nullptr),
+    has_pending_notification_(false) {
+  g_now = start_time_;
+  time_overrides_ = std::make_unique<base::subtle::ScopedTimeClockOverrides>(
+      &Now, nullptr, nullptr);
+
+  ads_ = std::make_unique<AdsImpl>(mock_ads_client_.get());
+
+  SetUpMockAdsClient();
+}
+
+TraceReplayer::~TraceReplayer() {
+  // |AdsImpl| must be destroyed while the clock is still overridden
+  ads_.reset();
+  time_overrides_.reset();
+}
+
+Result TraceReplayer::ParseTrace(
+    const std::string& json,
+    std::vector<TraceEventInfo>* trace,
+    std::string* error_description) {
+  if (!trace) {
+    return FAILED;
+  }
+
+  auto lines = base::SplitString(json, "\n", base::TRIM_WHITESPACE,
+      base::SPLIT_WANT_NONEMPTY);
+
+  std::vector<TraceEventInfo> events;
+  events.reserve(lines.size());
+
+  for (const auto& line : lines) {
+    TraceEventInfo event;
+    if (event.FromJson(line, error_description) != SUCCESS) {
+      return FAILED;
+    }
+
+    events.push_back(event);
+  }
+
+  *trace = std::move(events);
+
+  return SUCCESS;
+}
+
+TraceReplayReport TraceReplayer::Replay(
+    const std::vector<TraceEventInfo>& trace) {
+  Measure("Initialize", [this]() {
+    ads_->Initialize();
+  });
+
+  for (const auto& event : trace) {
+    auto time = start_time_ +
+        base::TimeDelta::FromSeconds(event.timestamp_in_seconds);
+    AdvanceClockTo(time);
+
+    Dispatch(event);
+    report_.events++;
+  }
+
+  for (auto& latency : report_.latencies) {
+    std::sort(latency.second.begin(), latency.second.end());
+  }
+
+  return report_;
+}
+
+AdsImpl* TraceReplayer::ads() const {
+  return ads_.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void TraceReplayer::SetUpMockAdsClient() {
+  ON_CALL(*mock_ads_client_, IsAdsEnabled())
+      .WillByDefault(Return(true));
+
+  ON_CALL(*mock_ads_client_, GetAdsLocale())
+      .WillByDefault(Return("en"));
+
+  ON_CALL(*mock_ads_client_, GetLocales())
+      .WillByDefault(Return(std::vector<std::string>{"en"}));
+
+  ON_CALL(*mock_ads_client_, GetAdsPerHour())
+      .WillByDefault(Return(kAdsPerHour));
+
+  ON_CALL(*mock_ads_client_, GetAdsPerDay())
+      .WillByDefault(Return(kAdsPerDay));
+
+  ON_CALL(*mock_ads_client_, IsNetworkConnectionAvailable())
+      .WillByDefault(Return(true));
+
+  ON_CALL(*mock_ads_client_, IsNotificationsAvailable())
+      .WillByDefault(Return(true));
+
+  ON_CALL(*mock_ads_client_, IsForeground())
+      .WillByDefault(Invoke([this]() {
+        return is_foreground_;
+      }));
+
+  ON_CALL(*mock_ads_client_, GenerateUUID())
+      .WillByDefault(Invoke([this]() {
+        auto uuid = std::to_string(next_uuid_++);
+        return "00000000-0000-4000-8000-" +
+            std::string(12 - std::min<size_t>(uuid.size(), 12), '0') + uuid;
+      }));
+
+  ON_CALL(*mock_ads_client_, SetTimer(_))
+      .WillByDefault(Invoke([this](
+          const uint64_t time_offset) {
+        return SetTimer(time_offset);
+      }));
+
+  ON_CALL(*mock_ads_client_, KillTimer(_))
+      .WillByDefault(Invoke([this](
+          const uint32_t timer_id) {
+        KillTimer(timer_id);
+      }));
+
+  ON_CALL(*mock_ads_client_, URLRequest(_, _, _, _, _, _))
+      .WillByDefault(
+          WithArg<5>(Invoke([this](
+              URLRequestCallback callback) {
+            report_.catalog_requests++;
+            callback(200, catalog_json_, {});
+          })));
+
+  ON_CALL(*mock_ads_client_, ShowNotification(_))
+      .WillByDefault(Invoke([this](
+          const std::unique_ptr<NotificationInfo>& info) {
+        report_.ads_served++;
+        last_notification_ = std::make_unique<NotificationInfo>(*info);
+        has_pending_notification_ = true;
+      }));
+
+  ON_CALL(*mock_ads_client_, Save(_, _, _))
+      .WillByDefault(Invoke([this](
+          const std::string& name,
+          const std::string& value,
+          OnSaveCallback callback) {
+        report_.save_calls++;
+        report_.save_bytes += value.size();
+        files_[name] = value;
+        callback(SUCCESS);
+      }));
+
+  ON_CALL(*mock_ads_client_, SaveBundleState(_, _))
+      .WillByDefault(
+          WithArg<1>(Invoke([](
+              OnSaveCallback callback) {
+            callback(SUCCESS);
+          })));
+
+  ON_CALL(*mock_ads_client_, CommitBundleState(_))
+      .WillByDefault(
+          WithArg<0>(Invoke([](
+              OnSaveCallback callback) {
+            callback(SUCCESS);
+          })));
+
+  ON_CALL(*mock_ads_client_, Load(_, _))
+      .WillByDefault(Invoke([this](
+          const std::string& name,
+          OnLoadCallback callback) {
+        auto file = files_.find(name);
+        if (file == files_.end()) {
+          callback(FAILED, "");
+          return;
+        }
+
+        callback(SUCCESS, file->second);
+      }));
+
+  ON_CALL(*mock_ads_client_, Reset(_, _))
+      .WillByDefault(Invoke([this](
+          const std::string& name,
+          OnResetCallback callback) {
+        files_.erase(name);
+        callback(SUCCESS);
+      }));
+
+  ON_CALL(*mock_ads_client_, LoadJsonSchema(_))
+      .WillByDefault(Invoke([](
+          const std::string& name) -> std::string {
+        return helper::TestData::LoadResource(name);
+      }));
+
+  ON_CALL(*mock_ads_client_, LoadUserModelForLocale(_, _))
+      .WillByDefault(Invoke([](
+          const std::string& locale,
+          OnLoadCallback callback) {
+        auto value = helper::TestData::LoadResource(
+            "locales/" + locale + "/user_model.json");
+        callback(value.empty() ? FAILED : SUCCESS, value);
+      }));
+
+  ON_CALL(*mock_ads_client_, LoadSampleBundle(_))
+      .WillByDefault(Invoke([](
+          OnLoadSampleBundleCallback callback) {
+        auto value = helper::TestData::LoadResource("sample_bundle.json");
+        callback(value.empty() ? FAILED : SUCCESS, value);
+      }));
+
+  ON_CALL(*mock_ads_client_, EventLog(_))
+      .WillByDefault(Invoke([this](
+          const std::string& json) {
+        report_.event_log_calls++;
+        report_.event_log_bytes += json.size();
+      }));
+}
+
+uint32_t TraceReplayer::SetTimer(const uint64_t time_offset) {
+  // Timers fire no sooner than a second after being set so that a timer which
+  // restarts itself cannot stall the virtual clock
+  auto delay = base::TimeDelta::FromSeconds(std::max<uint64_t>(time_offset, 1));
+
+  auto timer_id = next_timer_id_++;
+  timers_[timer_id] = g_now + delay;
+
+  return timer_id;
+}
+
+void TraceReplayer::KillTimer(const uint32_t timer_id) {
+  timers_.erase(timer_id);
+}
+
+void TraceReplayer::AdvanceClockTo(const base::Time& time) {
+  while (true) {
+    auto next_timer = timers_.end();
+    for (auto timer = timers_.begin(); timer != timers_.end(); timer++) {
+      if (timer->second > time) {
+        continue;
+      }
+
+      if (next_timer == timers_.end() || timer->second < next_timer->second) {
+        next_timer = timer;
+      }
+    }
+
+    if (next_timer == timers_.end()) {
+      break;
+    }
+
+    auto timer_id = next_timer->first;
+    if (next_timer->second > g_now) {
+      g_now = next_timer->second;
+    }
+
+    timers_.erase(next_timer);
+    report_.timers_fired++;
+
+    Measure("OnTimer", [this, timer_id]() {
+      ads_->OnTimer(timer_id);
+    });
+
+    ReportNotificationShown();
+  }
+
+  if (time > g_now) {
+    g_now = time;
+  }
+}
+
+void TraceReplayer::Dispatch(const TraceEventInfo& event) {
+  switch (event.type) {
+    case TAB_UPDATED_TRACE_EVENT: {
+      Measure("TabUpdated", [this, &event]() {
+        ads_->TabUpdated(event.tab_id, event.url, event.is_active,
+            event.is_incognito);
+      });
+
+      break;
+    }
+
+    case CLASSIFY_PAGE_TRACE_EVENT: {
+      Measure("ClassifyPage", [this, &event]() {
+        ads_->ClassifyPage(event.url, event.html);
+      });
+
+      break;
+    }
+
+    case TAB_CLOSED_TRACE_EVENT: {
+      Measure("TabClosed", [this, &event]() {
+        ads_->TabClosed(event.tab_id);
+      });
+
+      break;
+    }
+
+    case MEDIA_PLAYING_TRACE_EVENT: {
+      Measure("OnMediaPlaying", [this, &event]() {
+        ads_->OnMediaPlaying(event.tab_id);
+      });
+
+      break;
+    }
+
+    case MEDIA_STOPPED_TRACE_EVENT: {
+      Measure("OnMediaStopped", [this, &event]() {
+        ads_->OnMediaStopped(event.tab_id);
+      });
+
+      break;
+    }
+
+    case IDLE_TRACE_EVENT: {
+      Measure("OnIdle", [this]() {
+        ads_->OnIdle();
+      });
+
+      break;
+    }
+
+    case UNIDLE_TRACE_EVENT: {
+      Measure("OnUnIdle", [this]() {
+        ads_->OnUnIdle();
+      });
+
+      break;
+    }
+
+    case FOREGROUND_TRACE_EVENT: {
+      is_foreground_ = true;
+
+      Measure("OnForeground", [this]() {
+        ads_->OnForeground();
+      });
+
+      break;
+    }
+
+    case BACKGROUND_TRACE_EVENT: {
+      is_foreground_ = false;
+
+      Measure("OnBackground", [this]() {
+        ads_->OnBackground();
+      });
+
+      break;
+    }
+
+    case NOTIFICATION_RESULT_TRACE_EVENT: {
+      if (!last_notification_) {
+        break;
+      }
+
+      auto info = std::move(last_notification_);
+      Measure("GenerateAdReportingNotificationResultEvent",
+          [this, &info, &event]() {
+        ads_->GenerateAdReportingNotificationResultEvent(*info,
+            event.result_type);
+      });
+
+      break;
+    }
+
+    case TIMER_TRACE_EVENT: {
+      // Timers are fired by the virtual clock as they are set, as recorded
+      // timer ids do not match the timers set during replay
+      break;
+    }
+  }
+
+  ReportNotificationShown();
+}
+
+void TraceReplayer::ReportNotificationShown() {
+  if (!has_pending_notification_ || !last_notification_) {
+    return;
+  }
+
+  has_pending_notification_ = false;
+
+  Measure("GenerateAdReportingNotificationShownEvent", [this]() {
+    ads_->GenerateAdReportingNotificationShownEvent(*last_notification_);
+  });
+}
+
+template <typename Callable>
+void TraceReplayer::Measure(const std::string& name, Callable callable) {
+  auto start = base::TimeTicks::Now();
+  callable();
+  auto latency = base::TimeTicks::Now() - start;
+
+  report_.latencies[name].push_back(latency.InMicroseconds());
+}
+
+}  // namespace ads
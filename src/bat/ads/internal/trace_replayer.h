@@ -0,0 +1,121 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_TRACE_REPLAYER_H_
+#define BAT_ADS_INTERNAL_TRACE_REPLAYER_H_
+
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "bat/ads/notification_info.h"
+#include "bat/ads/result.h"
+
+#include "bat/ads/internal/trace_event_info.h"
+
+#include "base/time/time.h"
+
+namespace base {
+namespace subtle {
+class ScopedTimeClockOverrides;
+}  // namespace subtle
+}  // namespace base
+
+namespace ads {
+
+class AdsImpl;
+class ReplayAdsClient;
+
+struct TraceReplayReport {
+  TraceReplayReport();
+  ~TraceReplayReport();
+
+  // Returns the specified percentile of |latencies| which must be sorted
+  static int64_t GetPercentile(
+      const std::vector<int64_t>& latencies,
+      const double percentile);
+
+  std::string ToString() const;
+
+  uint64_t events;
+  uint64_t timers_fired;
+  uint64_t ads_served;
+  uint64_t save_calls;
+  uint64_t save_bytes;
+  uint64_t event_log_calls;
+  uint64_t event_log_bytes;
+  uint64_t catalog_requests;
+
+  // Wall clock latency in microseconds of each call into |Ads| by name, sorted
+  // in ascending order
+  std::map<std::string, std::vector<int64_t>> latencies;
+};
+
+// Replays a browsing session through |AdsImpl| on top of |MockAdsClient|.
+// |base::Time::Now| is overridden with a virtual clock which jumps from event
+// to event, firing the timers set by |AdsImpl| on the way, so that days of
+// browsing replay in seconds. State saved by |AdsImpl| is kept in memory and
+// loaded back as a client would, and catalog requests are answered with
+// |catalog_json|. Only one replayer may exist at a time
+class TraceReplayer {
+ public:
+  explicit TraceReplayer(const std::string& catalog_json);
+  ~TraceReplayer();
+
+  // Parses a trace of one JSON encoded |TraceEventInfo| per line
+  static Result ParseTrace(
+      const std::string& json,
+      std::vector<TraceEventInfo>* trace,
+      std::string* error_description = nullptr);
+
+  // Initializes |AdsImpl| and replays |trace|, which must be ordered by
+  // timestamp. Timestamps are relative to when the replayer was created
+  TraceReplayReport Replay(const std::vector<TraceEventInfo>& trace);
+
+  AdsImpl* ads() const;
+
+ private:
+  void SetUpMockAdsClient();
+
+  uint32_t SetTimer(const uint64_t time_offset);
+  void KillTimer(const uint32_t timer_id);
+
+  // Advances the virtual clock to |time|, firing due timers in order
+  void AdvanceClockTo(const base::Time& time);
+
+  void Dispatch(const TraceEventInfo& event);
+
+  // Reports the shown event for the last notification, as the client does
+  // once a notification has been displayed
+  void ReportNotificationShown();
+
+  template <typename Callable>
+  void Measure(const std::string& name, Callable callable);
+
+  std::unique_ptr<ReplayAdsClient> mock_ads_client_;
+  std::unique_ptr<AdsImpl> ads_;
+  std::unique_ptr<base::subtle::ScopedTimeClockOverrides> time_overrides_;
+
+  std::string catalog_json_;
+  std::map<std::string, std::string> files_;
+
+  base::Time start_time_;
+  std::map<uint32_t, base::Time> timers_;
+  uint32_t next_timer_id_;
+
+  uint64_t next_uuid_;
+  bool is_foreground_;
+
+  std::unique_ptr<NotificationInfo> last_notification_;
+  bool has_pending_notification_;
+
+  TraceReplayReport report_;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_TRACE_REPLAYER_H_
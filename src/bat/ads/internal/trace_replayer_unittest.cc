@@ -0,0 +1,129 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "bat/ads/internal/synthetic_data_generator.h"
+#include "bat/ads/internal/test_data_helper.h"
+#include "bat/ads/internal/trace_replayer.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ads {
+
+class TraceReplayerTest : public ::testing::Test {
+ protected:
+  TraceReplayerTest() {
+    // You can do set-up work for each test here
+  }
+
+  ~TraceReplayerTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  std::vector<TraceEventInfo> GetTrace() {
+    SyntheticTraceOptions options;
+    options.days = 2;
+    options.page_loads_per_day = 50;
+
+    SyntheticDataGenerator generator(1);
+    return generator.GenerateTrace(options);
+  }
+};
+
+TEST_F(TraceReplayerTest, ParseTrace) {
+  // Arrange
+  auto trace = GetTrace();
+
+  std::string json;
+  for (const auto& event : trace) {
+    json += event.ToJson() + "\n";
+  }
+
+  // Act
+  std::vector<TraceEventInfo> parsed_trace;
+  auto result = TraceReplayer::ParseTrace(json, &parsed_trace);
+
+  // Assert
+  EXPECT_EQ(SUCCESS, result);
+  ASSERT_EQ(trace.size(), parsed_trace.size());
+  for (size_t i = 0; i < trace.size(); i++) {
+    EXPECT_EQ(trace.at(i).ToJson(), parsed_trace.at(i).ToJson());
+  }
+}
+
+TEST_F(TraceReplayerTest, ParseTraceWithUnknownEventType) {
+  // Arrange
+  std::string json = "{\"timestamp\":1,\"type\":\"OnIdle\"}\n"
+      "{\"timestamp\":2,\"type\":\"Unknown\"}\n";
+
+  // Act
+  std::vector<TraceEventInfo> trace;
+  std::string error_description;
+  auto result = TraceReplayer::ParseTrace(json, &trace, &error_description);
+
+  // Assert
+  EXPECT_EQ(FAILED, result);
+  EXPECT_TRUE(trace.empty());
+  EXPECT_FALSE(error_description.empty());
+}
+
+TEST_F(TraceReplayerTest, Replay) {
+  // Arrange
+  auto trace = GetTrace();
+
+  uint64_t tab_updated_events = 0;
+  for (const auto& event : trace) {
+    if (event.type == TAB_UPDATED_TRACE_EVENT) {
+      tab_updated_events++;
+    }
+  }
+
+  TraceReplayer replayer(helper::TestData::Load("catalog.json"));
+
+  // Act
+  auto report = replayer.Replay(trace);
+
+  // Assert
+  EXPECT_EQ(trace.size(), report.events);
+  EXPECT_GT(report.timers_fired, 0UL);
+  EXPECT_GT(report.save_calls, 0UL);
+  EXPECT_GT(report.catalog_requests, 0UL);
+  EXPECT_EQ(tab_updated_events, report.latencies["TabUpdated"].size());
+}
+
+TEST_F(TraceReplayerTest, GetPercentile) {
+  // Arrange
+  std::vector<int64_t> latencies;
+  for (int64_t i = 1; i <= 100; i++) {
+    latencies.push_back(i);
+  }
+
+  // Act
+  auto p50 = TraceReplayReport::GetPercentile(latencies, 50);
+  auto p99 = TraceReplayReport::GetPercentile(latencies, 99);
+  auto max = TraceReplayReport::GetPercentile(latencies, 100);
+
+  // Assert
+  EXPECT_EQ(50, p50);
+  EXPECT_EQ(99, p99);
+  EXPECT_EQ(100, max);
+}
+
+TEST_F(TraceReplayerTest, GetPercentileWithoutLatencies) {
+  // Arrange
+  std::vector<int64_t> latencies;
+
+  // Act
+  auto percentile = TraceReplayReport::GetPercentile(latencies, 50);
+
+  // Assert
+  EXPECT_EQ(0, percentile);
+}
+
+}  // namespace ads
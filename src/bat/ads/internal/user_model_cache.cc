@@ -0,0 +1,212 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "bat/ads/internal/user_model_cache.h"
+#include "bat/ads/internal/logging.h"
+#include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/time_helper.h"
+#include "bat/ads/internal/trace_log.h"
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+
+namespace ads {
+
+UserModelCache::UserModelCache(
+    AdsClient* ads_client,
+    const size_t capacity) :
+    capacity_(capacity),
+    generation_(0),
+    next_load_id_(0),
+    ads_client_(ads_client) {
+}
+
+UserModelCache::~UserModelCache() = default;
+
+usermodel::UserModel* UserModelCache::Get(
+    const std::string& locale,
+    OnUserModelLoadedCallback callback) {
+  auto* user_model = Find(locale);
+  if (user_model) {
+    return user_model;
+  }
+
+  auto is_loading = IsLoading(locale);
+  if (!is_loading && HasRecentlyFailedToLoad(locale)) {
+    return nullptr;
+  }
+
+  auto& callbacks = pending_callbacks_[locale];
+  if (callback) {
+    callbacks.push_back(callback);
+  }
+
+  if (is_loading) {
+    return nullptr;
+  }
+
+  BLOG(INFO) << "Loading user model for " << locale;
+
+  auto load_id = ++next_load_id_;
+  auto load_callback = std::bind(&UserModelCache::OnUserModelLoaded, this,
+      generation_, load_id, locale, _1, _2);
+
+  ADS_TRACE_ASYNC_BEGIN("UserModelCache::Load",
+      reinterpret_cast<const void*>(static_cast<uintptr_t>(load_id)));
+  ads_client_->LoadUserModelForLocale(locale, load_callback);
+
+  return Find(locale);
+}
+
+bool UserModelCache::Has(const std::string& locale) const {
+  for (const auto& user_model : user_models_) {
+    if (user_model.first == locale) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool UserModelCache::IsLoading(const std::string& locale) const {
+  return pending_callbacks_.find(locale) != pending_callbacks_.end();
+}
+
+bool UserModelCache::HasRecentlyFailedToLoad(const std::string& locale) const {
+  auto it = failed_load_timestamps_in_seconds_.find(locale);
+  if (it == failed_load_timestamps_in_seconds_.end()) {
+    return false;
+  }
+
+  auto now_in_seconds = helper::Time::NowInSeconds();
+  if (now_in_seconds >= it->second + kRetryLoadingUserModelAfterSeconds) {
+    return false;
+  }
+
+  return true;
+}
+
+void UserModelCache::Clear() {
+  user_models_.clear();
+  pending_callbacks_.clear();
+  failed_load_timestamps_in_seconds_.clear();
+
+  generation_++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void UserModelCache::OnUserModelLoaded(
+    const uint64_t generation,
+    const uint64_t load_id,
+    const std::string& locale,
+    const Result result,
+    const std::string& json) {
+  ADS_TRACE_ASYNC_END("UserModelCache::Load",
+      reinterpret_cast<const void*>(static_cast<uintptr_t>(load_id)));
+
+  if (generation != generation_) {
+    return;
+  }
+
+  if (result != SUCCESS) {
+    BLOG(ERROR) << "Failed to load user model for " << locale;
+
+    OnLoadFailed(locale);
+    return;
+  }
+
+  BLOG(INFO) << "Successfully loaded user model for " << locale;
+
+  // The user model is only referenced by the background task until it has
+  // been parsed, so it is safe to initialize off the calling thread
+  std::shared_ptr<usermodel::UserModel> user_model(
+      usermodel::UserModel::CreateInstance());
+  auto user_model_json = std::make_shared<std::string>(json);
+
+  auto task = [user_model, user_model_json]() {
+    ADS_TRACE_EVENT("UserModelCache::Parse");
+
+    user_model->InitializePageClassifier(*user_model_json);
+  };
+
+  auto callback = std::bind(&UserModelCache::OnUserModelParsed, this,
+      generation, locale, user_model);
+
+  ads_client_->RunInBackground(task, callback);
+}
+
+void UserModelCache::OnUserModelParsed(
+    const uint64_t generation,
+    const std::string& locale,
+    std::shared_ptr<usermodel::UserModel> user_model) {
+  if (generation != generation_) {
+    return;
+  }
+
+  if (!user_model->IsInitialized()) {
+    BLOG(ERROR) << "Failed to initialize user model for " << locale;
+
+    OnLoadFailed(locale);
+    return;
+  }
+
+  BLOG(INFO) << "Initialized user model for " << locale;
+
+  failed_load_timestamps_in_seconds_.erase(locale);
+
+  Add(locale, std::move(user_model));
+
+  RunCallbacks(locale, SUCCESS);
+}
+
+void UserModelCache::Add(
+    const std::string& locale,
+    std::shared_ptr<usermodel::UserModel> user_model) {
+  user_models_.emplace_front(locale, std::move(user_model));
+
+  while (user_models_.size() > capacity_) {
+    BLOG(INFO) << "Evicted user model for " << user_models_.back().first;
+
+    user_models_.pop_back();
+  }
+}
+
+void UserModelCache::OnLoadFailed(const std::string& locale) {
+  failed_load_timestamps_in_seconds_[locale] = helper::Time::NowInSeconds();
+
+  RunCallbacks(locale, FAILED);
+}
+
+void UserModelCache::RunCallbacks(
+    const std::string& locale,
+    const Result result) {
+  auto it = pending_callbacks_.find(locale);
+  if (it == pending_callbacks_.end()) {
+    return;
+  }
+
+  auto callbacks = std::move(it->second);
+  pending_callbacks_.erase(it);
+
+  for (const auto& callback : callbacks) {
+    callback(result);
+  }
+}
+
+usermodel::UserModel* UserModelCache::Find(const std::string& locale) {
+  for (auto it = user_models_.begin(); it != user_models_.end(); ++it) {
+    if (it->first != locale) {
+      continue;
+    }
+
+    user_models_.splice(user_models_.begin(), user_models_, it);
+    return user_models_.front().second.get();
+  }
+
+  return nullptr;
+}
+
+}  // namespace ads
@@ -0,0 +1,108 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BAT_ADS_INTERNAL_USER_MODEL_CACHE_H_
+#define BAT_ADS_INTERNAL_USER_MODEL_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <functional>
+
+#include "bat/ads/ads_client.h"
+
+#include "bat/usermodel/user_model.h"
+
+namespace ads {
+
+using OnUserModelLoadedCallback = std::function<void(const Result)>;
+
+// Loads user models on demand and keeps the user models for the most recently
+// used locales, so that switching back to one of those locales does not reload
+// and parse its user model again. User models are parsed in the background,
+// see |AdsClient::RunInBackground|
+class UserModelCache {
+ public:
+  UserModelCache(AdsClient* ads_client, const size_t capacity);
+  ~UserModelCache();
+
+  // Returns the user model for |locale| and marks it as the most recently used
+  // user model. Returns nullptr if the user model has not been loaded, in which
+  // case it is loaded and |callback| is called once loading has finished.
+  // Requests for a locale which is already loading share the same load. If the
+  // Client loads synchronously the user model is returned and |callback| has
+  // already been called. If loading the user model failed less than
+  // |kRetryLoadingUserModelAfterSeconds| ago nullptr is returned without
+  // loading it again and |callback| is not called
+  usermodel::UserModel* Get(
+      const std::string& locale,
+      OnUserModelLoadedCallback callback);
+
+  bool Has(const std::string& locale) const;
+  bool IsLoading(const std::string& locale) const;
+  bool HasRecentlyFailedToLoad(const std::string& locale) const;
+
+  // Removes all user models and failed loads, loads which are in flight are
+  // discarded and their callbacks are not called
+  void Clear();
+
+ private:
+  void OnUserModelLoaded(
+      const uint64_t generation,
+      const uint64_t load_id,
+      const std::string& locale,
+      const Result result,
+      const std::string& json);
+
+  void OnUserModelParsed(
+      const uint64_t generation,
+      const std::string& locale,
+      std::shared_ptr<usermodel::UserModel> user_model);
+
+  void Add(
+      const std::string& locale,
+      std::shared_ptr<usermodel::UserModel> user_model);
+
+  void OnLoadFailed(const std::string& locale);
+
+  void RunCallbacks(const std::string& locale, const Result result);
+
+  usermodel::UserModel* Find(const std::string& locale);
+
+  // Ordered from the most to the least recently used
+  std::list<std::pair<std::string, std::shared_ptr<usermodel::UserModel>>>
+      user_models_;
+
+  std::map<std::string, std::vector<OnUserModelLoadedCallback>>
+      pending_callbacks_;
+
+  // When loading the user model for each locale last failed, so that a user
+  // model which cannot be loaded is not requested again on every use
+  std::map<std::string, uint64_t> failed_load_timestamps_in_seconds_;
+
+  size_t capacity_;
+
+  // Incremented by |Clear| so that loads which were in flight are discarded
+  uint64_t generation_;
+
+  // Identifies each load in the trace log, as loads for different locales can
+  // be in flight at the same time
+  uint64_t next_load_id_;
+
+  AdsClient* ads_client_;  // NOT OWNED
+
+  // Not copyable, not assignable
+  UserModelCache(const UserModelCache&) = delete;
+  UserModelCache& operator=(const UserModelCache&) = delete;
+};
+
+}  // namespace ads
+
+#endif  // BAT_ADS_INTERNAL_USER_MODEL_CACHE_H_
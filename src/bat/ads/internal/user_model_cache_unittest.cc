@@ -0,0 +1,232 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bat/ads/internal/ads_client_mock.h"
+#include "bat/ads/internal/static_values.h"
+#include "bat/ads/internal/test_data_helper.h"
+#include "bat/ads/internal/user_model_cache.h"
+
+#include "base/time/time.h"
+#include "base/time/time_override.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+namespace ads {
+
+namespace {
+
+double now_in_seconds = 0;
+
+base::Time Now() {
+  return base::Time::FromDoubleT(now_in_seconds);
+}
+
+}  // namespace
+
+class UserModelCacheTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<NiceMock<MockAdsClient>> mock_ads_client_;
+  std::unique_ptr<UserModelCache> user_model_cache_;
+  std::unique_ptr<base::subtle::ScopedTimeClockOverrides> time_overrides_;
+
+  std::string user_model_;
+
+  // Loads which have been requested but not completed, in request order
+  std::vector<std::pair<std::string, OnLoadCallback>> pending_loads_;
+
+  std::vector<Result> results_;
+
+  UserModelCacheTest() :
+      mock_ads_client_(std::make_unique<NiceMock<MockAdsClient>>()),
+      user_model_cache_(std::make_unique<UserModelCache>(
+          mock_ads_client_.get(), 2)),
+      time_overrides_(std::make_unique<base::subtle::ScopedTimeClockOverrides>(
+          &Now, nullptr, nullptr)) {
+    // You can do set-up work for each test here
+    now_in_seconds = 1559347200;
+  }
+
+  ~UserModelCacheTest() override {
+    // You can do clean-up work that doesn't throw exceptions here
+  }
+
+  // If the constructor and destructor are not enough for setting up and
+  // cleaning up each test, you can use the following methods
+
+  void SetUp() override {
+    // Code here will be called immediately after the constructor (right before
+    // each test)
+
+    user_model_ = helper::TestData::LoadResource("locales/en/user_model.json");
+
+    ON_CALL(*mock_ads_client_, LoadUserModelForLocale(_, _))
+        .WillByDefault(Invoke([this](
+            const std::string& locale,
+            OnLoadCallback callback) {
+          pending_loads_.push_back({locale, callback});
+        }));
+  }
+
+  void TearDown() override {
+    // Code here will be called immediately after each test (right before the
+    // destructor)
+  }
+
+  // Objects declared here can be used by all tests in the test case
+  OnUserModelLoadedCallback RecordResult() {
+    return [this](const Result result) {
+      results_.push_back(result);
+    };
+  }
+
+  void CompletePendingLoads() {
+    auto pending_loads = std::move(pending_loads_);
+    pending_loads_.clear();
+
+    for (const auto& pending_load : pending_loads) {
+      pending_load.second(SUCCESS, user_model_);
+    }
+  }
+
+  void Load(const std::string& locale) {
+    user_model_cache_->Get(locale, nullptr);
+    CompletePendingLoads();
+  }
+};
+
+TEST_F(UserModelCacheTest, ReturnsUserModelOnceLoaded) {
+  // Arrange
+  auto* user_model = user_model_cache_->Get("en", RecordResult());
+
+  // Act
+  CompletePendingLoads();
+
+  // Assert
+  EXPECT_EQ(nullptr, user_model);
+  EXPECT_EQ(std::vector<Result>({SUCCESS}), results_);
+  EXPECT_NE(nullptr, user_model_cache_->Get("en", RecordResult()));
+  EXPECT_EQ(1UL, results_.size());
+}
+
+TEST_F(UserModelCacheTest, SharesLoadForSameLocale) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, LoadUserModelForLocale("en", _))
+      .Times(1);
+
+  user_model_cache_->Get("en", RecordResult());
+
+  // Act
+  user_model_cache_->Get("en", RecordResult());
+  CompletePendingLoads();
+
+  // Assert
+  EXPECT_EQ(std::vector<Result>({SUCCESS, SUCCESS}), results_);
+}
+
+TEST_F(UserModelCacheTest, EvictsLeastRecentlyUsedUserModel) {
+  // Arrange
+  Load("en");
+  Load("de");
+  user_model_cache_->Get("en", nullptr);
+
+  // Act
+  Load("fr");
+
+  // Assert
+  EXPECT_TRUE(user_model_cache_->Has("en"));
+  EXPECT_FALSE(user_model_cache_->Has("de"));
+  EXPECT_TRUE(user_model_cache_->Has("fr"));
+}
+
+TEST_F(UserModelCacheTest, FailedLoadIsNotCached) {
+  // Arrange
+  user_model_cache_->Get("en", RecordResult());
+
+  // Act
+  pending_loads_.front().second(FAILED, "");
+
+  // Assert
+  EXPECT_EQ(std::vector<Result>({FAILED}), results_);
+  EXPECT_FALSE(user_model_cache_->Has("en"));
+  EXPECT_FALSE(user_model_cache_->IsLoading("en"));
+}
+
+TEST_F(UserModelCacheTest, DoesNotReloadRecentlyFailedUserModel) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, LoadUserModelForLocale("en", _))
+      .Times(1);
+
+  user_model_cache_->Get("en", RecordResult());
+  pending_loads_.front().second(FAILED, "");
+
+  now_in_seconds += kRetryLoadingUserModelAfterSeconds - 1;
+
+  // Act
+  auto* user_model = user_model_cache_->Get("en", RecordResult());
+
+  // Assert
+  EXPECT_EQ(nullptr, user_model);
+  EXPECT_EQ(std::vector<Result>({FAILED}), results_);
+  EXPECT_TRUE(user_model_cache_->HasRecentlyFailedToLoad("en"));
+  EXPECT_FALSE(user_model_cache_->IsLoading("en"));
+}
+
+TEST_F(UserModelCacheTest, ReloadsFailedUserModelAfterBackoff) {
+  // Arrange
+  EXPECT_CALL(*mock_ads_client_, LoadUserModelForLocale("en", _))
+      .Times(2);
+
+  user_model_cache_->Get("en", RecordResult());
+  pending_loads_.front().second(FAILED, "");
+  pending_loads_.clear();
+
+  now_in_seconds += kRetryLoadingUserModelAfterSeconds;
+
+  // Act
+  user_model_cache_->Get("en", RecordResult());
+  CompletePendingLoads();
+
+  // Assert
+  EXPECT_EQ(std::vector<Result>({FAILED, SUCCESS}), results_);
+  EXPECT_TRUE(user_model_cache_->Has("en"));
+  EXPECT_FALSE(user_model_cache_->HasRecentlyFailedToLoad("en"));
+}
+
+TEST_F(UserModelCacheTest, FailedLoadDoesNotAffectOtherLocales) {
+  // Arrange
+  user_model_cache_->Get("en", RecordResult());
+  pending_loads_.front().second(FAILED, "");
+  pending_loads_.clear();
+
+  // Act
+  user_model_cache_->Get("de", RecordResult());
+  CompletePendingLoads();
+
+  // Assert
+  EXPECT_EQ(std::vector<Result>({FAILED, SUCCESS}), results_);
+  EXPECT_TRUE(user_model_cache_->Has("de"));
+}
+
+TEST_F(UserModelCacheTest, ClearDiscardsLoadsInFlight) {
+  // Arrange
+  user_model_cache_->Get("en", RecordResult());
+
+  // Act
+  user_model_cache_->Clear();
+  CompletePendingLoads();
+
+  // Assert
+  EXPECT_TRUE(results_.empty());
+  EXPECT_FALSE(user_model_cache_->Has("en"));
+}
+
+}  // namespace ads
@@ -15,6 +15,12 @@ IssuerInfo::IssuerInfo(const IssuerInfo& info) :
     name(info.name),
     public_key(info.public_key) {}
 
+IssuerInfo::IssuerInfo(IssuerInfo&& info) noexcept = default;
+
+IssuerInfo& IssuerInfo::operator=(const IssuerInfo& info) = default;
+
+IssuerInfo& IssuerInfo::operator=(IssuerInfo&& info) noexcept = default;
+
 IssuerInfo::~IssuerInfo() = default;
 
 }  // namespace ads
@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <utility>
+
 #include "bat/ads/issuers_info.h"
 
 #include "bat/ads/internal/json_helper.h"
@@ -17,6 +19,12 @@ IssuersInfo::IssuersInfo(const IssuersInfo& info) :
     public_key(info.public_key),
     issuers(info.issuers) {}
 
+IssuersInfo::IssuersInfo(IssuersInfo&& info) noexcept = default;
+
+IssuersInfo& IssuersInfo::operator=(const IssuersInfo& info) = default;
+
+IssuersInfo& IssuersInfo::operator=(IssuersInfo&& info) noexcept = default;
+
 IssuersInfo::~IssuersInfo() = default;
 
 const std::string IssuersInfo::ToJson() const {
@@ -68,7 +76,7 @@ Result IssuersInfo::FromJson(
     new_issuers.push_back(info);
   }
 
-  issuers = new_issuers;
+  issuers = std::move(new_issuers);
 
   return SUCCESS;
 }
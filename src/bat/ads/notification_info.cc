@@ -25,6 +25,14 @@ NotificationInfo::NotificationInfo(const NotificationInfo& info) :
     url(info.url),
     uuid(info.uuid) {}
 
+NotificationInfo::NotificationInfo(NotificationInfo&& info) noexcept = default;
+
+NotificationInfo& NotificationInfo::operator=(
+    const NotificationInfo& info) = default;
+
+NotificationInfo& NotificationInfo::operator=(
+    NotificationInfo&& info) noexcept = default;
+
 NotificationInfo::~NotificationInfo() = default;
 
 const std::string NotificationInfo::ToJson() const {